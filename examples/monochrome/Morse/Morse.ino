@@ -0,0 +1,19 @@
+#include <Arduino.h>
+
+#include "roo_blink.h"
+#include "roo_time.h"
+
+using namespace roo_blink;
+
+Blinker blinker(roo_blink::esp32::BuiltinLed());
+
+void setup() {
+  // Steps are generated on the fly as the message plays, so memory use does
+  // not depend on the message length.
+  blinker.loop(BlinkSequence::FromSource(
+      std::make_shared<MorseSource>("Hello world", roo_time::Millis(100))));
+}
+
+void loop() {
+  // You're free to do as you please; it will not interfefe with the blinker.
+}
@@ -0,0 +1,40 @@
+#include <Arduino.h>
+
+#include "roo_blink.h"
+#include "roo_time.h"
+
+using namespace roo_blink;
+
+Blinker blinker(roo_blink::esp32::BuiltinLed());
+
+// An encoded monochrome pattern, e.g. generated on the host with
+// EncodePattern(). Since it is constant, it stays in flash, and the blinker
+// plays it from there, without copying. Steps:
+// * turn on, hold 100ms;
+// * turn off, hold 100ms;
+// * fade on over 300ms, fade off over 300ms;
+// * hold 400ms.
+static const uint8_t kPattern[] = {
+    0x52, 0x42, 0x4C, 0x4B, 0x01, 0x00, 0x07, 0x00,  // Header.
+    0x00, 0xFF, 0xFF, 0x00, 0x00,                    // TurnOn()
+    0x01, 0x00, 0x00, 0x64, 0x00,                    // Hold(100ms)
+    0x00, 0x00, 0x00, 0x00, 0x00,                    // TurnOff()
+    0x01, 0x00, 0x00, 0x64, 0x00,                    // Hold(100ms)
+    0x02, 0xFF, 0xFF, 0x2C, 0x01,                    // FadeOn(300ms)
+    0x02, 0x00, 0x00, 0x2C, 0x01,                    // FadeOff(300ms)
+    0x01, 0x00, 0x00, 0x90, 0x01,                    // Hold(400ms)
+};
+
+void setup() {
+  Serial.begin(115200);
+  PatternStatus status = ValidatePattern(kPattern, sizeof(kPattern));
+  if (status != PatternStatus::kOk) {
+    Serial.printf("Invalid pattern: %s\n", PatternStatusName(status));
+    return;
+  }
+  blinker.loop(BlinkSequence::FromPattern(kPattern, sizeof(kPattern)));
+}
+
+void loop() {
+  // You're free to do as you please; it will not interfefe with the blinker.
+}
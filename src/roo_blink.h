@@ -2,12 +2,25 @@
 
 /// Umbrella header for the roo_blink module.
 ///
-/// Provides monochrome and RGB LED blinking helpers.
+/// Provides monochrome, RGB, RGBW, and tunable-white LED blinking helpers.
 
+#include "roo_blink/frame_scheduler.h"
 #include "roo_blink/monochrome/blinker.h"
 #include "roo_blink/monochrome/led.h"
+#include "roo_blink/pattern/codec.h"
+#include "roo_blink/pattern/format.h"
+#include "roo_blink/playback.h"
 #include "roo_blink/rgb/blinker.h"
 #include "roo_blink/rgb/led.h"
+#include "roo_blink/rgb/power_budget.h"
+#include "roo_blink/rgbw/blinker.h"
+#include "roo_blink/rgbw/led.h"
+#include "roo_blink/source/digits.h"
+#include "roo_blink/source/morse.h"
+#include "roo_blink/source/step_source.h"
+#include "roo_blink/trace.h"
+#include "roo_blink/white/blinker.h"
+#include "roo_blink/white/led.h"
 
 #ifdef ESP32
 #include "roo_blink/monochrome/led_esp32.h"
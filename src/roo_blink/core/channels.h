@@ -0,0 +1,231 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "roo_blink/pattern/format.h"
+#include "roo_blink/rgb/color.h"
+#include "roo_blink/rgb/interpolation.h"
+#include "roo_blink/rgbw/color.h"
+#include "roo_blink/white/color.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// Describes how the state of an LED, represented by Value, breaks down into
+/// channels. The blink engine, sequences, and the pattern codec are written
+/// against this description, so that a single implementation serves all LED
+/// types. Specializations are provided for monochrome (uint16_t), RGB
+/// (Color), RGBW (RgbwColor), and tunable-white (White) LEDs. Each provides:
+///
+///   // Number of channels, and the number of bytes (1 or 2) used to store
+///   // each channel in pattern records.
+///   static constexpr int kChannels;
+///   static constexpr int kChannelBytes;
+///
+///   // Kind of the patterns that hold steps of this Value.
+///   static constexpr PatternKind kPatternKind;
+///
+///   // Returns the value with all channels at maximum.
+///   static constexpr Value Full();
+///
+///   // Converts to and from per-channel levels.
+///   static void Split(Value value, uint16_t* channels);
+///   static Value Join(const uint16_t* channels);
+///
+///   // Computes intermediate values of software fades; see
+///   // internal::LinearFade.
+///   using Interpolator = ...;
+///
+///   // Writes the value to the LED.
+///   template <typename LedT>
+///   static void Write(LedT& led, Value value);
+///
+///   // Starts a hardware fade, if the LED supports it. Returns false if it
+///   // does not, in which case the fade is done in software.
+///   template <typename LedT>
+///   static bool HardwareFade(LedT& led, Value target,
+///                            roo_time::Duration duration);
+template <typename Value>
+struct ChannelTraits;
+
+namespace internal {
+
+// Interpolates linearly, channel by channel, between two values.
+template <typename Value>
+class LinearFade {
+ public:
+  LinearFade() : from_(), to_() {}
+
+  // Prepares the fade between the specified values. Linear fades have a
+  // single interpolation mode, so `interpolation` is ignored.
+  void start(Value from, Value to, uint8_t /*interpolation*/) {
+    ChannelTraits<Value>::Split(from, from_);
+    ChannelTraits<Value>::Split(to, to_);
+  }
+
+  // Returns the value at the specified progress, with 65536 corresponding to
+  // the end of the fade.
+  Value at(uint32_t progress) const {
+    uint16_t channels[kChannels];
+    for (int i = 0; i < kChannels; ++i) {
+      int32_t delta = (int32_t)to_[i] - from_[i];
+      channels[i] =
+          (uint16_t)(from_[i] + (int32_t)(((int64_t)delta * progress) >> 16));
+    }
+    return ChannelTraits<Value>::Join(channels);
+  }
+
+ private:
+  static constexpr int kChannels = ChannelTraits<Value>::kChannels;
+
+  uint16_t from_[kChannels];
+  uint16_t to_[kChannels];
+};
+
+}  // namespace internal
+
+template <>
+struct ChannelTraits<uint16_t> {
+  static constexpr int kChannels = 1;
+  static constexpr int kChannelBytes = 2;
+  static constexpr PatternKind kPatternKind = PatternKind::kMonochrome;
+
+  static constexpr uint16_t Full() { return 65535; }
+
+  static void Split(uint16_t level, uint16_t* channels) {
+    channels[0] = level;
+  }
+
+  static uint16_t Join(const uint16_t* channels) { return channels[0]; }
+
+  using Interpolator = internal::LinearFade<uint16_t>;
+
+  template <typename LedT>
+  static void Write(LedT& led, uint16_t level) {
+    led.setLevel(level);
+  }
+
+  template <typename LedT>
+  static bool HardwareFade(LedT& led, uint16_t target,
+                           roo_time::Duration duration) {
+    return led.fade(target, duration);
+  }
+};
+
+template <>
+struct ChannelTraits<Color> {
+  static constexpr int kChannels = 3;
+  static constexpr int kChannelBytes = 1;
+  static constexpr PatternKind kPatternKind = PatternKind::kRgb;
+
+  static constexpr Color Full() { return Color(255, 255, 255); }
+
+  static void Split(Color color, uint16_t* channels) {
+    channels[0] = color.r();
+    channels[1] = color.g();
+    channels[2] = color.b();
+  }
+
+  static Color Join(const uint16_t* channels) {
+    return Color(channels[0], channels[1], channels[2]);
+  }
+
+  // Supports the RgbInterpolation modes.
+  using Interpolator = internal::ColorFade;
+
+  template <typename LedT>
+  static void Write(LedT& led, Color color) {
+    led.setColor(color);
+  }
+
+  template <typename LedT>
+  static bool HardwareFade(LedT& /*led*/, Color /*target*/,
+                           roo_time::Duration /*duration*/) {
+    return false;
+  }
+};
+
+template <>
+struct ChannelTraits<RgbwColor> {
+  static constexpr int kChannels = 4;
+  static constexpr int kChannelBytes = 1;
+  static constexpr PatternKind kPatternKind = PatternKind::kRgbw;
+
+  static constexpr RgbwColor Full() { return RgbwColor(255, 255, 255, 255); }
+
+  static void Split(RgbwColor color, uint16_t* channels) {
+    channels[0] = color.r();
+    channels[1] = color.g();
+    channels[2] = color.b();
+    channels[3] = color.w();
+  }
+
+  static RgbwColor Join(const uint16_t* channels) {
+    return RgbwColor(channels[0], channels[1], channels[2], channels[3]);
+  }
+
+  using Interpolator = internal::LinearFade<RgbwColor>;
+
+  template <typename LedT>
+  static void Write(LedT& led, RgbwColor color) {
+    led.setColor(color);
+  }
+
+  template <typename LedT>
+  static bool HardwareFade(LedT& /*led*/, RgbwColor /*target*/,
+                           roo_time::Duration /*duration*/) {
+    return false;
+  }
+};
+
+template <>
+struct ChannelTraits<White> {
+  static constexpr int kChannels = 2;
+  static constexpr int kChannelBytes = 2;
+  static constexpr PatternKind kPatternKind = PatternKind::kWhite;
+
+  static constexpr White Full() { return White(65535, 65535); }
+
+  static void Split(White white, uint16_t* channels) {
+    channels[0] = white.warm();
+    channels[1] = white.cool();
+  }
+
+  static White Join(const uint16_t* channels) {
+    return White(channels[0], channels[1]);
+  }
+
+  using Interpolator = internal::LinearFade<White>;
+
+  template <typename LedT>
+  static void Write(LedT& led, White white) {
+    led.setWhite(white);
+  }
+
+  template <typename LedT>
+  static bool HardwareFade(LedT& /*led*/, White /*target*/,
+                           roo_time::Duration /*duration*/) {
+    return false;
+  }
+};
+
+namespace internal {
+
+// Returns the channels of the value, packed big-endian into 32 bits.
+template <typename Value>
+uint32_t PackChannels(Value value) {
+  using Traits = ChannelTraits<Value>;
+  static_assert(Traits::kChannels * Traits::kChannelBytes <= 4,
+                "Value too wide to pack");
+  uint16_t channels[Traits::kChannels];
+  Traits::Split(value, channels);
+  uint32_t packed = 0;
+  for (int i = 0; i < Traits::kChannels; ++i) {
+    packed = (packed << (8 * Traits::kChannelBytes)) | channels[i];
+  }
+  return packed;
+}
+
+}  // namespace internal
+
+}  // namespace roo_blink
@@ -0,0 +1,156 @@
+#include "roo_blink/core/engine.h"
+
+namespace roo_blink {
+namespace internal {
+
+BlinkerCore::BlinkerCore(roo_scheduler::Scheduler& scheduler)
+    : stepper_(scheduler, [this]() { step(); }),
+      repetitions_(0),
+      round_started_(false),
+      fade_in_progress_(false),
+      frames_(nullptr),
+      frame_priority_(FramePriority::kNormal),
+      frame_pending_(false),
+      frame_id_(0),
+      frame_next_(nullptr),
+      tracer_(nullptr),
+      trace_channel_(0) {}
+
+BlinkerCore::BlinkerCore(FrameScheduler& frames, FramePriority priority)
+    : BlinkerCore(frames.scheduler()) {
+  frames_ = &frames;
+  frame_priority_ = priority;
+}
+
+BlinkerCore::~BlinkerCore() {
+  cancelFrame();
+  std::shared_ptr<PlaybackState> cancelled;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    cancelled = std::move(playback_);
+  }
+  // Detaches the handles, which may outlive the blinker, and wakes up
+  // waiters.
+  if (cancelled != nullptr) cancelled->finish(PlaybackStatus::kCancelled);
+}
+
+void BlinkerCore::setTracer(TraceRecorder* tracer, uint16_t channel) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  tracer_ = tracer;
+  trace_channel_ = channel;
+}
+
+Playback BlinkerCore::restart(roo::unique_lock<roo::mutex>& lock, bool empty,
+                              int repetitions) {
+  std::shared_ptr<PlaybackState> superseded = std::move(playback_);
+  if (superseded != nullptr) trace(TraceEvent::kSupersede, 0);
+  std::shared_ptr<PlaybackState> playback;
+  if (!empty) {
+    playback_ = std::make_shared<PlaybackState>(this);
+    playback = playback_;
+  }
+  repetitions_ = repetitions;
+  round_started_ = false;
+  fade_in_progress_ = false;
+  // A pending fade update would otherwise advance the new sequence, too.
+  cancelFrame();
+  if (!empty) trace(TraceEvent::kStart, (uint32_t)repetitions);
+  if (!empty) {
+    // Replaces the pending step of the previous sequence, if any.
+    step_due_ = roo_time::Uptime::Now();
+    stepper_.scheduleNow(roo_scheduler::PRIORITY_ELEVATED);
+  } else {
+    applyTerminal();
+  }
+  lock.unlock();
+  if (superseded != nullptr) {
+    superseded->finish(PlaybackStatus::kSuperseded);
+  }
+  return Playback(std::move(playback));
+}
+
+bool BlinkerCore::nextRound() {
+  if (repetitions_ == 0 || !round_started_) return false;
+  if (repetitions_ > 0) --repetitions_;
+  round_started_ = false;
+  return true;
+}
+
+void BlinkerCore::scheduleStep(uint16_t delay_millis) {
+  trace(TraceEvent::kSchedule, delay_millis);
+  step_due_ = roo_time::Uptime::Now() + roo_time::Millis(delay_millis);
+  stepper_.scheduleAfter(roo_time::Millis(delay_millis),
+                         roo_scheduler::PRIORITY_ELEVATED);
+}
+
+void BlinkerCore::scheduleFadeTick() {
+  if (frames_ != nullptr) {
+    trace(TraceEvent::kFrameRequest, 0);
+    frames_->request(this);
+  } else {
+    scheduleStep(kFadeTickMillis);
+  }
+}
+
+void BlinkerCore::cancelFrame() {
+  if (frames_ != nullptr) frames_->cancel(this);
+}
+
+void BlinkerCore::startFade(uint16_t duration_millis) {
+  fade_in_progress_ = true;
+  fade_start_time_ = roo_time::Uptime::Now();
+  fade_end_time_ = fade_start_time_ + roo_time::Millis(duration_millis);
+}
+
+bool BlinkerCore::fadeProgress(uint32_t& progress) {
+  roo_time::Uptime now = roo_time::Uptime::Now();
+  if (now >= fade_end_time_) {
+    fade_in_progress_ = false;
+    return false;
+  }
+  // Fixed-point progress, with 65536 corresponding to the end.
+  progress = (uint32_t)(((now - fade_start_time_).inMicros() << 16) /
+                        (fade_end_time_ - fade_start_time_).inMicros());
+  return true;
+}
+
+void BlinkerCore::step(const roo_time::Uptime* frame_due) {
+  std::shared_ptr<PlaybackState> completed;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    // Pending step of a sequence that has since been cancelled, or replaced
+    // by set().
+    if (playback_ == nullptr) return;
+    if (frame_due != nullptr) step_due_ = *frame_due;
+    if (tracing()) {
+      roo_time::Uptime now = roo_time::Uptime::Now();
+      trace(TraceEvent::kStep,
+            now > step_due_ ? (uint32_t)(now - step_due_).inMicros() : 0);
+    }
+    if (!advance()) {
+      completed = std::move(playback_);
+      trace(TraceEvent::kComplete, 0);
+    }
+  }
+  if (completed != nullptr) completed->finish(PlaybackStatus::kCompleted);
+}
+
+void BlinkerCore::cancelPlayback(PlaybackState* state) {
+  std::shared_ptr<PlaybackState> cancelled;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    if (playback_.get() != state) return;
+    cancelled = std::move(playback_);
+    trace(TraceEvent::kCancel, 0);
+    repetitions_ = 0;
+    round_started_ = false;
+    fade_in_progress_ = false;
+    cancelFrame();
+    clearSequence();
+    applyTerminal();
+  }
+  cancelled->finish(PlaybackStatus::kCancelled);
+}
+
+}  // namespace internal
+}  // namespace roo_blink
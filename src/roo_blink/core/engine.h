@@ -0,0 +1,386 @@
+#pragma once
+
+#include <memory>
+
+#include "roo_blink/core/channels.h"
+#include "roo_blink/core/sequence.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/default_scheduler.h"
+#include "roo_blink/frame_scheduler.h"
+#include "roo_blink/playback.h"
+#include "roo_blink/trace.h"
+#include "roo_scheduler.h"
+#include "roo_threads.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+namespace internal {
+
+// The part of the blink engine that does not depend on the LED type: the
+// playback lifecycle, repetitions, scheduling, and fade timing. It is
+// compiled once, and shared by all BlinkEngine instantiations.
+class BlinkerCore : public PlaybackOwner {
+ public:
+  /// Starts recording output writes and scheduling events of this blinker in
+  /// the tracer, as the specified channel. Pass nullptr to stop recording.
+  void setTracer(TraceRecorder* tracer, uint16_t channel = 0);
+
+ protected:
+  // Interval between updates of software fades.
+  static constexpr uint16_t kFadeTickMillis = 20;
+
+  explicit BlinkerCore(roo_scheduler::Scheduler& scheduler);
+  BlinkerCore(FrameScheduler& frames, FramePriority priority);
+  ~BlinkerCore();
+
+  // Executes the sequence up to the next delay. Returns false when the
+  // sequence has ended. Called with the mutex held.
+  virtual bool advance() = 0;
+
+  // Drops the sequence and resets the read position. Called with the mutex
+  // held.
+  virtual void clearSequence() = 0;
+
+  // Sets the LED to the terminal value. Called with the mutex held.
+  virtual void applyTerminal() = 0;
+
+  // Starts playing the sequence that has just been set, with the specified
+  // number of repetitions (-1 for infinite), superseding the previous
+  // playback. If the sequence is empty, applies the terminal value instead.
+  // Must be called with the mutex held via `lock`; releases it.
+  Playback restart(roo::unique_lock<roo::mutex>& lock, bool empty,
+                   int repetitions);
+
+  // Called at the end of the sequence. Returns true if it should be played
+  // again.
+  bool nextRound();
+
+  // Records that a step of the current repetition has been executed.
+  void markRoundStarted() { round_started_ = true; }
+
+  // Schedules the next call to advance().
+  void scheduleStep(uint16_t delay_millis);
+
+  // Schedules the next call to advance() during a software fade: in the
+  // next frame, if attached to a FrameScheduler, or after kFadeTickMillis
+  // otherwise.
+  void scheduleFadeTick();
+
+  // Starts timing a software fade, of the specified duration.
+  void startFade(uint16_t duration_millis);
+
+  bool fadeInProgress() const { return fade_in_progress_; }
+
+  // Sets the progress of the fade, with 65536 corresponding to the end, and
+  // returns true, if the fade is still in progress. Otherwise, ends the fade,
+  // and returns false.
+  bool fadeProgress(uint32_t& progress);
+
+  bool tracing() const { return tracer_ != nullptr; }
+
+  // Records the event, if tracing. Called with the mutex held.
+  void trace(TraceEvent event, uint32_t value) {
+    if (tracer_ != nullptr) tracer_->record(trace_channel_, event, value);
+  }
+
+  mutable roo::mutex mutex_;
+
+ private:
+  friend class roo_blink::FrameScheduler;
+
+  // Runs the next step. If `frame_due` is set, the step is run by the frame
+  // scheduler, in the frame due at that time.
+  void step(const roo_time::Uptime* frame_due = nullptr);
+
+  void cancelPlayback(PlaybackState* state) override;
+
+  // Drops the update queued in the frame scheduler, if any.
+  void cancelFrame();
+
+  roo_scheduler::SingletonTask stepper_;
+  int repetitions_;
+
+  // Whether any step has been executed in the current repetition.
+  bool round_started_;
+
+  // Completion state of the current sequence, if any.
+  std::shared_ptr<PlaybackState> playback_;
+
+  // For when hardware fading is not supported.
+  bool fade_in_progress_;
+  roo_time::Uptime fade_start_time_;
+  roo_time::Uptime fade_end_time_;
+
+  // Frame scheduler that drives software fades, if any. The remaining fields
+  // are guarded by its mutex.
+  FrameScheduler* frames_;
+  FramePriority frame_priority_;
+  bool frame_pending_;
+  uint32_t frame_id_;
+  BlinkerCore* frame_next_;
+
+  TraceRecorder* tracer_;
+  uint16_t trace_channel_;
+
+  // When the next step was meant to run; used to trace its lateness.
+  roo_time::Uptime step_due_;
+};
+
+}  // namespace internal
+
+/// Runs blink sequences on an LED of type LedT, whose state is represented
+/// by Value. The same engine serves monochrome, RGB, RGBW, and tunable-white
+/// LEDs; see ChannelTraits for the methods that LedT needs to provide. They
+/// are called directly, rather than via the abstract LED interfaces, so that
+/// they can be inlined for LED types that are known at compile time.
+///
+/// Usually used via the aliases: Blinker, RgbBlinker, RgbwBlinker, and
+/// WhiteBlinker (which accept any LED implementing the respective abstract
+/// interface), or BasicBlinker<LedT>, BasicRgbBlinker<LedT>, etc.
+template <typename Value, typename LedT>
+class BlinkEngine : public internal::BlinkerCore {
+ public:
+  /// Constructs a blinker using the default scheduler.
+  BlinkEngine(LedT& led);
+
+  /// Constructs a blinker using the specified scheduler.
+  BlinkEngine(LedT& led, roo_scheduler::Scheduler& scheduler);
+
+  /// Constructs a blinker whose software fades are updated in the frames of
+  /// the specified frame scheduler (see FrameScheduler), with the specified
+  /// priority. Other steps run on the frame scheduler's scheduler.
+  BlinkEngine(LedT& led, FrameScheduler& frames,
+              FramePriority priority = FramePriority::kNormal);
+
+  /// Repeats the sequence indefinitely. The returned handle can be used to
+  /// cancel the playback, or to get notified when it gets superseded.
+  Playback loop(BasicSequence<Value> sequence);
+
+  /// Repeats the sequence the specified number of times, then sets the LED to
+  /// the terminal value. The returned handle can be used to wait for, or to
+  /// get notified about, completion. If `repetitions` is not positive, sets
+  /// the terminal value right away, and returns a completed handle.
+  Playback repeat(BasicSequence<Value> sequence, int repetitions,
+                  Value terminal = Value());
+
+  /// Executes the sequence once, then sets the LED to the terminal value. The
+  /// returned handle can be used to wait for, or to get notified about,
+  /// completion.
+  Playback execute(BasicSequence<Value> sequence, Value terminal = Value());
+
+  /// Sets the LED to the specified value (level, or color).
+  void set(Value value);
+
+  /// Same as set(); reads better for color LEDs.
+  void setColor(Value color) { set(color); }
+
+  /// Sets all channels of the LED to the maximum.
+  void turnOn();
+
+  /// Disables the LED.
+  void turnOff();
+
+ private:
+  using Traits = ChannelTraits<Value>;
+  using StepT = BasicStep<Value>;
+
+  Playback updateSequence(BasicSequence<Value> sequence, int repetitions,
+                          Value terminal);
+
+  bool advance() override;
+  void clearSequence() override;
+  void applyTerminal() override;
+
+  // Retrieves the next step of the sequence, if any.
+  bool nextStep(StepT& step);
+
+  void write() {
+    Traits::Write(led_, current_);
+    if (tracing()) trace(TraceEvent::kWrite, internal::PackChannels(current_));
+  }
+
+  LedT& led_;
+  BasicSequence<Value> sequence_;
+  Value current_;
+  Value terminal_;
+
+  // Position of the next step to read from the sequence.
+  size_t pos_;
+
+  // Steps read ahead of time, so that sources are not called for each step.
+  static constexpr size_t kReadAhead = 4;
+  StepT lookahead_[kReadAhead];
+  uint8_t lookahead_pos_;
+  uint8_t lookahead_count_;
+
+  // For when hardware fading is not supported.
+  typename Traits::Interpolator fade_;
+  Value fade_target_;
+};
+
+// Implementation details.
+
+template <typename Value, typename LedT>
+BlinkEngine<Value, LedT>::BlinkEngine(LedT& led)
+    : BlinkEngine(led, DefaultScheduler()) {}
+
+template <typename Value, typename LedT>
+BlinkEngine<Value, LedT>::BlinkEngine(LedT& led,
+                                      roo_scheduler::Scheduler& scheduler)
+    : BlinkerCore(scheduler),
+      led_(led),
+      sequence_(),
+      current_(),
+      terminal_(),
+      pos_(0),
+      lookahead_pos_(0),
+      lookahead_count_(0) {}
+
+template <typename Value, typename LedT>
+BlinkEngine<Value, LedT>::BlinkEngine(LedT& led, FrameScheduler& frames,
+                                      FramePriority priority)
+    : BlinkerCore(frames, priority),
+      led_(led),
+      sequence_(),
+      current_(),
+      terminal_(),
+      pos_(0),
+      lookahead_pos_(0),
+      lookahead_count_(0) {}
+
+template <typename Value, typename LedT>
+Playback BlinkEngine<Value, LedT>::loop(BasicSequence<Value> sequence) {
+  return updateSequence(std::move(sequence), -1, Value());
+}
+
+template <typename Value, typename LedT>
+Playback BlinkEngine<Value, LedT>::repeat(BasicSequence<Value> sequence,
+                                          int repetitions, Value terminal) {
+  if (repetitions <= 0) return updateSequence({}, 0, terminal);
+  return updateSequence(std::move(sequence), repetitions - 1, terminal);
+}
+
+template <typename Value, typename LedT>
+Playback BlinkEngine<Value, LedT>::execute(BasicSequence<Value> sequence,
+                                           Value terminal) {
+  return updateSequence(std::move(sequence), 0, terminal);
+}
+
+template <typename Value, typename LedT>
+void BlinkEngine<Value, LedT>::set(Value value) {
+  updateSequence({}, 0, value);
+}
+
+template <typename Value, typename LedT>
+void BlinkEngine<Value, LedT>::turnOn() {
+  set(Traits::Full());
+}
+
+template <typename Value, typename LedT>
+void BlinkEngine<Value, LedT>::turnOff() {
+  set(Value());
+}
+
+template <typename Value, typename LedT>
+Playback BlinkEngine<Value, LedT>::updateSequence(
+    BasicSequence<Value> sequence, int repetitions, Value terminal) {
+  roo::unique_lock<roo::mutex> lock(mutex_);
+  clearSequence();
+  sequence_ = std::move(sequence);
+  terminal_ = terminal;
+  current_ = terminal;
+  sequence_.rewind();
+  return restart(lock, sequence_.empty(), repetitions);
+}
+
+template <typename Value, typename LedT>
+void BlinkEngine<Value, LedT>::clearSequence() {
+  sequence_ = BasicSequence<Value>();
+  pos_ = 0;
+  lookahead_pos_ = 0;
+  lookahead_count_ = 0;
+}
+
+template <typename Value, typename LedT>
+void BlinkEngine<Value, LedT>::applyTerminal() {
+  current_ = terminal_;
+  write();
+}
+
+template <typename Value, typename LedT>
+bool BlinkEngine<Value, LedT>::advance() {
+  if (fadeInProgress()) {
+    uint32_t progress;
+    if (fadeProgress(progress)) {
+      current_ = fade_.at(progress);
+      write();
+      scheduleFadeTick();
+      return true;
+    }
+    current_ = fade_target_;
+    write();
+  }
+  uint16_t next_delay = 0;
+  do {
+    StepT s;
+    if (!nextStep(s)) {
+      clearSequence();
+      applyTerminal();
+      return false;
+    }
+    switch (s.type_) {
+      case StepT::kSet: {
+        current_ = s.target_;
+        write();
+        break;
+      }
+      case StepT::kHold: {
+        next_delay = s.duration_millis_;
+        break;
+      }
+      case StepT::kFade:
+      default: {
+        if (Traits::HardwareFade(led_, s.target_,
+                                 roo_time::Millis(s.duration_millis_))) {
+          if (tracing()) {
+            trace(TraceEvent::kFade, internal::PackChannels(s.target_));
+          }
+          current_ = s.target_;
+          next_delay = s.duration_millis_;
+        } else {
+          fade_.start(current_, s.target_, s.interpolation_);
+          fade_target_ = s.target_;
+          startFade(s.duration_millis_);
+          scheduleFadeTick();
+          return true;
+        }
+        break;
+      }
+    }
+  } while (next_delay == 0);
+  scheduleStep(next_delay);
+  return true;
+}
+
+template <typename Value, typename LedT>
+bool BlinkEngine<Value, LedT>::nextStep(StepT& step) {
+  if (lookahead_pos_ == lookahead_count_) {
+    lookahead_pos_ = 0;
+    lookahead_count_ = sequence_.read(pos_, lookahead_, kReadAhead);
+    pos_ += lookahead_count_;
+    if (lookahead_count_ == 0) {
+      // End of the sequence. Start over if there are repetitions left (and
+      // the sequence is not empty).
+      if (!nextRound()) return false;
+      pos_ = 0;
+      sequence_.rewind();
+      return nextStep(step);
+    }
+  }
+  step = lookahead_[lookahead_pos_++];
+  markRoundStarted();
+  return true;
+}
+
+}  // namespace roo_blink
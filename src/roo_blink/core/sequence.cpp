@@ -0,0 +1,108 @@
+#include "roo_blink/core/sequence.h"
+
+#include "roo_blink/pattern/codec.h"
+#include "roo_blink/pattern/format.h"
+#include "roo_logging.h"
+
+using namespace roo_time;
+
+namespace roo_blink {
+
+template <typename Value>
+BasicSequence<Value> BasicSequence<Value>::FromPattern(const uint8_t* data,
+                                                       size_t size) {
+  PatternStatus status = ValidatePattern(data, size);
+  CHECK(status == PatternStatus::kOk)
+      << "Invalid pattern: " << PatternStatusName(status);
+  CHECK(PatternKindOf(data) == ChannelTraits<Value>::kPatternKind)
+      << "Pattern kind does not match the LED type";
+  BasicSequence result;
+  result.pattern_ = data + kPatternHeaderSize;
+  result.pattern_size_ = PatternStepCount(data);
+  return result;
+}
+
+template <typename Value>
+BasicSequence<Value> BasicSequence<Value>::FromSource(
+    std::shared_ptr<StepSource<BasicStep<Value>>> source) {
+  CHECK(source != nullptr);
+  BasicSequence result;
+  result.source_ = std::move(source);
+  return result;
+}
+
+template <typename Value>
+BasicStep<Value> BasicSequence<Value>::stepAt(size_t pos) const {
+  if (pattern_ == nullptr) return sequence_[pos];
+  return internal::PatternCodec::Decode<Value>(
+      pattern_ + pos * PatternRecordSize(ChannelTraits<Value>::kPatternKind));
+}
+
+template <typename Value>
+size_t BasicSequence<Value>::read(size_t pos, BasicStep<Value>* buf,
+                                  size_t max_count) {
+  if (source_ != nullptr) return source_->read(buf, max_count);
+  size_t count = 0;
+  while (count < max_count && pos + count < size()) {
+    buf[count] = stepAt(pos + count);
+    ++count;
+  }
+  return count;
+}
+
+template <typename Value>
+void BasicSequence<Value>::rewind() {
+  if (source_ != nullptr) source_->rewind();
+}
+
+template <typename Value>
+BasicSequence<Value> BasicBlink(roo_time::Duration period, Value on,
+                                int duty_percent, int rampup_percent_on,
+                                int rampup_percent_off) {
+  CHECK_GE(duty_percent, 0);
+  CHECK_LE(duty_percent, 100);
+  CHECK_GE(rampup_percent_on, 0);
+  CHECK_LE(rampup_percent_on, 100);
+  CHECK_GE(rampup_percent_off, 0);
+  CHECK_LE(rampup_percent_off, 100);
+  int millis = period.inMillis();
+  int millis_1st = duty_percent * millis / 100;
+  int millis_1st_rampup = rampup_percent_on * millis_1st / 100;
+  int millis_2nd = millis - millis_1st;
+  int millis_2nd_rampup = rampup_percent_off * millis_2nd / 100;
+
+  BasicSequence<Value> result;
+
+  if (millis_1st_rampup > 0) {
+    result.add(BasicFadeTo(on, Millis(millis_1st_rampup)));
+  } else {
+    result.add(BasicSetTo(on));
+  }
+  if (millis_1st_rampup < millis_1st) {
+    result.add(BasicHold<Value>(Millis(millis_1st - millis_1st_rampup)));
+  }
+
+  if (millis_2nd_rampup > 0) {
+    result.add(BasicFadeTo(Value(), Millis(millis_2nd_rampup)));
+  } else {
+    result.add(BasicSetTo(Value()));
+  }
+  if (millis_2nd_rampup < millis_2nd) {
+    result.add(BasicHold<Value>(Millis(millis_2nd - millis_2nd_rampup)));
+  }
+
+  return result;
+}
+
+template class BasicSequence<uint16_t>;
+template class BasicSequence<Color>;
+template class BasicSequence<RgbwColor>;
+template class BasicSequence<White>;
+
+template BasicSequence<uint16_t> BasicBlink(Duration, uint16_t, int, int, int);
+template BasicSequence<Color> BasicBlink(Duration, Color, int, int, int);
+template BasicSequence<RgbwColor> BasicBlink(Duration, RgbwColor, int, int,
+                                             int);
+template BasicSequence<White> BasicBlink(Duration, White, int, int, int);
+
+}  // namespace roo_blink
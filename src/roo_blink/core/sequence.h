@@ -0,0 +1,98 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "roo_blink/core/channels.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/source/step_source.h"
+#include "roo_logging.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// Sequence of steps for blinking an LED whose state is represented by Value
+/// (see ChannelTraits).
+template <typename Value>
+class BasicSequence {
+ public:
+  /// Creates an empty sequence.
+  BasicSequence() = default;
+
+  /// Creates a sequence that plays steps directly from an encoded pattern
+  /// (see roo_blink/pattern/format.h), without copying it. The pattern must
+  /// be of the kind matching Value, and it must stay valid and unchanged for
+  /// as long as the sequence is in use.
+  ///
+  /// The pattern must be well-formed; use ValidatePattern() to check
+  /// patterns that come from untrusted sources.
+  static BasicSequence FromPattern(const uint8_t* data, size_t size);
+
+  /// Creates a sequence that pulls steps from the source as it plays, so that
+  /// memory use does not depend on the sequence length.
+  static BasicSequence FromSource(
+      std::shared_ptr<StepSource<BasicStep<Value>>> source);
+
+  /// Appends the step to the sequence. Must not be called on sequences
+  /// created with FromPattern() or FromSource().
+  void add(BasicStep<Value> step) {
+    CHECK(pattern_ == nullptr && source_ == nullptr)
+        << "Can't add steps to a pattern or source sequence";
+    sequence_.push_back(std::move(step));
+  }
+
+  /// Returns the number of steps in the sequence. Must not be called on
+  /// sequences created with FromSource().
+  size_t size() const {
+    CHECK(source_ == nullptr) << "Source sequences have no predefined size";
+    return pattern_ != nullptr ? pattern_size_ : sequence_.size();
+  }
+
+  /// Returns true if the sequence was created with FromSource(), in which case
+  /// the steps are not known until played.
+  bool hasSource() const { return source_ != nullptr; }
+
+  /// Returns true if the sequence is known to have no steps.
+  bool empty() const {
+    return source_ == nullptr &&
+           (pattern_ != nullptr ? pattern_size_ : sequence_.size()) == 0;
+  }
+
+ private:
+  template <typename V, typename LedT>
+  friend class BlinkEngine;
+  friend class internal::PatternCodec;
+
+  BasicStep<Value> stepAt(size_t pos) const;
+
+  // Reads up to max_count steps, starting at pos, into buf. Returns the
+  // number of steps read; zero at the end of the sequence.
+  size_t read(size_t pos, BasicStep<Value>* buf, size_t max_count);
+
+  // Restarts a source-backed sequence.
+  void rewind();
+
+  std::vector<BasicStep<Value>> sequence_;
+
+  // When set, points to the first step record of an encoded pattern.
+  const uint8_t* pattern_ = nullptr;
+  size_t pattern_size_ = 0;
+
+  std::shared_ptr<StepSource<BasicStep<Value>>> source_;
+};
+
+/// Creates a symmetric blink sequence, alternating between `on` and off, with
+/// optional ramp-up/down segments.
+template <typename Value>
+BasicSequence<Value> BasicBlink(roo_time::Duration period, Value on,
+                                int duty_percent = 50,
+                                int rampup_percent_on = 0,
+                                int rampup_percent_off = 0);
+
+// Sequences are compiled once, in sequence.cpp, for all supported LED types.
+extern template class BasicSequence<uint16_t>;
+extern template class BasicSequence<Color>;
+extern template class BasicSequence<RgbwColor>;
+extern template class BasicSequence<White>;
+
+}  // namespace roo_blink
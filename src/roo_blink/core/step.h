@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "roo_blink/core/channels.h"
+#include "roo_blink/pattern/format.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+namespace internal {
+class PatternCodec;
+}
+
+template <typename Value, typename LedT>
+class BlinkEngine;
+
+template <typename Value>
+class BasicStep;
+
+/// Creates a step that sets the LED to the specified value instantly.
+template <typename Value>
+constexpr BasicStep<Value> BasicSetTo(Value value);
+
+/// Creates a step that fades to the target value over the duration. The
+/// meaning of `interpolation` depends on the Value type; for Color, it is an
+/// RgbInterpolation. Other types support linear interpolation only, and
+/// ignore it.
+template <typename Value>
+constexpr BasicStep<Value> BasicFadeTo(Value value,
+                                       roo_time::Duration duration,
+                                       uint8_t interpolation = 0);
+
+/// Creates a step that maintains the current value for the duration.
+template <typename Value>
+constexpr BasicStep<Value> BasicHold(roo_time::Duration duration);
+
+/// Single step of a blink sequence, for an LED whose state is represented by
+/// Value (see ChannelTraits).
+template <typename Value>
+class BasicStep {
+ private:
+  template <typename V>
+  friend constexpr BasicStep<V> BasicSetTo(V value);
+  template <typename V>
+  friend constexpr BasicStep<V> BasicFadeTo(V value,
+                                            roo_time::Duration duration,
+                                            uint8_t interpolation);
+  template <typename V>
+  friend constexpr BasicStep<V> BasicHold(roo_time::Duration duration);
+
+  template <typename V, typename LedT>
+  friend class BlinkEngine;
+  friend class internal::PatternCodec;
+
+  enum Type : uint8_t { kSet, kHold, kFade };
+
+  constexpr BasicStep() : BasicStep(kHold, Value(), 0, 0) {}
+  constexpr BasicStep(Type type, Value target, uint16_t duration_millis,
+                      uint8_t interpolation);
+
+  // Ordered to avoid padding.
+  Value target_;
+  uint16_t duration_millis_;
+  Type type_;
+  uint8_t interpolation_;
+};
+
+// Implementation details.
+
+template <typename Value>
+constexpr BasicStep<Value>::BasicStep(Type type, Value target,
+                                      uint16_t duration_millis,
+                                      uint8_t interpolation)
+    : target_(target),
+      duration_millis_(duration_millis),
+      type_(type),
+      interpolation_(interpolation) {}
+
+template <typename Value>
+constexpr BasicStep<Value> BasicSetTo(Value value) {
+  return BasicStep<Value>(BasicStep<Value>::kSet, value, 0, 0);
+}
+
+template <typename Value>
+constexpr BasicStep<Value> BasicFadeTo(Value value,
+                                       roo_time::Duration duration,
+                                       uint8_t interpolation) {
+  return BasicStep<Value>(
+      BasicStep<Value>::kFade, value, (uint16_t)duration.inMillis(),
+      PatternHasInterpolation(ChannelTraits<Value>::kPatternKind)
+          ? interpolation
+          : 0);
+}
+
+template <typename Value>
+constexpr BasicStep<Value> BasicHold(roo_time::Duration duration) {
+  return BasicStep<Value>(BasicStep<Value>::kHold, Value(),
+                          (uint16_t)duration.inMillis(), 0);
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,152 @@
+#include "roo_blink/frame_scheduler.h"
+
+#include "roo_blink/core/engine.h"
+#include "roo_blink/default_scheduler.h"
+
+namespace roo_blink {
+
+FrameScheduler::FrameScheduler(roo_time::Duration budget,
+                               roo_time::Duration period)
+    : FrameScheduler(DefaultScheduler(), budget, period) {}
+
+FrameScheduler::FrameScheduler(roo_scheduler::Scheduler& scheduler,
+                               roo_time::Duration budget,
+                               roo_time::Duration period)
+    : scheduler_(scheduler),
+      task_(scheduler, [this]() { slice(); }),
+      budget_(budget),
+      period_(period),
+      frame_id_(0),
+      slice_(0) {}
+
+FrameStats FrameScheduler::stats() const {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  return stats_;
+}
+
+void FrameScheduler::resetStats() {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  stats_ = FrameStats();
+}
+
+void FrameScheduler::request(internal::BlinkerCore* blinker) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  if (blinker->frame_pending_) return;
+  blinker->frame_pending_ = true;
+  blinker->frame_id_ = frame_id_;
+  blinker->frame_next_ = nullptr;
+  Queue& queue = queues_[(int)blinker->frame_priority_];
+  if (queue.tail == nullptr) {
+    queue.head = blinker;
+  } else {
+    queue.tail->frame_next_ = blinker;
+  }
+  queue.tail = blinker;
+  if (!task_.is_scheduled()) {
+    due_ = roo_time::Uptime::Now() + period_;
+    task_.scheduleOn(due_, roo_scheduler::PRIORITY_ELEVATED);
+  }
+}
+
+void FrameScheduler::cancel(internal::BlinkerCore* blinker) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  if (!blinker->frame_pending_) return;
+  blinker->frame_pending_ = false;
+  Queue& queue = queues_[(int)blinker->frame_priority_];
+  internal::BlinkerCore* prev = nullptr;
+  internal::BlinkerCore** ptr = &queue.head;
+  while (*ptr != blinker) {
+    prev = *ptr;
+    ptr = &(*ptr)->frame_next_;
+  }
+  *ptr = blinker->frame_next_;
+  if (queue.tail == blinker) queue.tail = prev;
+}
+
+void FrameScheduler::slice() {
+  roo_time::Uptime start = roo_time::Uptime::Now();
+  uint32_t frame_id;
+  uint8_t slice;
+  roo_time::Uptime due;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    if (slice_ == 0) {
+      // Updates queued from now on (e.g. by blinkers continuing their fades)
+      // are stamped with the new id, and wait for the next frame.
+      ++frame_id_;
+      frame_start_ = start;
+      ++stats_.frames;
+    }
+    frame_id = frame_id_;
+    slice = slice_;
+    due = due_;
+  }
+  // Only the first slice of a frame promotes a low-priority update.
+  bool promoted = (slice != 0);
+  while (true) {
+    internal::BlinkerCore* blinker;
+    {
+      roo::lock_guard<roo::mutex> lock(mutex_);
+      Queue* queue = nullptr;
+      Queue& low = queues_[(int)FramePriority::kLow];
+      bool aged = !promoted && low.head != nullptr &&
+                  frame_id - low.head->frame_id_ > kMaxLowPriorityDeferrals;
+      if (aged) {
+        // Deferred too many times; goes ahead, regardless of the budget, so
+        // that low-priority blinkers don't starve.
+        queue = &low;
+        promoted = true;
+      } else {
+        for (Queue& q : queues_) {
+          if (q.head != nullptr && q.head->frame_id_ != frame_id) {
+            queue = &q;
+            break;
+          }
+        }
+        // Out of updates, or out of budget for this slice.
+        if (queue == nullptr) break;
+        if (roo_time::Uptime::Now() - start >= budget_) break;
+      }
+      blinker = queue->head;
+      queue->head = blinker->frame_next_;
+      if (queue->head == nullptr) queue->tail = nullptr;
+      blinker->frame_pending_ = false;
+    }
+    // Runs without the lock, since the blinker may queue its next update.
+    blinker->step(&due);
+  }
+  roo_time::Duration elapsed = roo_time::Uptime::Now() - start;
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  if (elapsed > stats_.max_frame_time) stats_.max_frame_time = elapsed;
+  // Whether some updates of this frame did not fit in the slice. Being older,
+  // they precede any updates queued for the next frame.
+  bool left = false;
+  for (const Queue& q : queues_) {
+    if (q.head != nullptr && q.head->frame_id_ != frame_id) left = true;
+  }
+  if (left && slice + 1 < kSlicesPerFrame) {
+    // Continues the frame in the next slice.
+    slice_ = slice + 1;
+    due_ = frame_start_ + roo_time::Micros(period_.inMicros() * slice_ /
+                                           kSlicesPerFrame);
+    if (due_ < roo_time::Uptime::Now()) due_ = roo_time::Uptime::Now();
+    task_.scheduleOn(due_, roo_scheduler::PRIORITY_ELEVATED);
+    return;
+  }
+  if (left) {
+    ++stats_.overruns;
+    for (const Queue& q : queues_) {
+      for (internal::BlinkerCore* b = q.head;
+           b != nullptr && b->frame_id_ != frame_id; b = b->frame_next_) {
+        ++stats_.deferred;
+      }
+    }
+  }
+  slice_ = 0;
+  if (queues_[0].head != nullptr || queues_[1].head != nullptr) {
+    due_ = frame_start_ + period_;
+    task_.scheduleOn(due_, roo_scheduler::PRIORITY_ELEVATED);
+  }
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "roo_scheduler.h"
+#include "roo_threads.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+namespace internal {
+class BlinkerCore;
+}
+
+/// Priority of a blinker attached to a FrameScheduler.
+enum class FramePriority : uint8_t {
+  /// Updated ahead of low-priority blinkers.
+  kNormal = 0,
+
+  /// Updated with the budget left over by normal-priority blinkers. The
+  /// first to be deferred to subsequent frames under load.
+  kLow = 1,
+};
+
+/// Frame timing statistics, accumulated since construction or the last
+/// resetStats().
+struct FrameStats {
+  /// Number of frames run.
+  uint32_t frames = 0;
+
+  /// Number of frames whose updates did not all fit in the slices of the
+  /// period.
+  uint32_t overruns = 0;
+
+  /// Number of blinker updates postponed to a later frame, because all
+  /// slices of their frame had used up their budget.
+  uint32_t deferred = 0;
+
+  /// Longest processing time of a single slice.
+  roo_time::Duration max_frame_time;
+};
+
+/// Batches the software fade updates of attached blinkers into periodic
+/// frames, time-sliced with a bounded CPU budget per slice.
+///
+/// Without it, every fading blinker schedules its own update every 20 ms.
+/// With many blinkers, these updates line up, and run as one long burst that
+/// delays all other tasks on the scheduler. Attached blinkers (see the
+/// BlinkEngine constructor) instead queue their fade updates here. Each frame
+/// processes the updates queued before it started, normal-priority first, in
+/// the order they were queued. The frame is split into up to 4 slices,
+/// spread evenly across the period; each slice runs updates until its budget
+/// is used up, and leaves the rest to the next slice, so that other tasks
+/// get to run in between. This bounds the time that a slice occupies the
+/// scheduler thread to the budget plus a single update, regardless of the
+/// number of blinkers. Updates that don't fit in any slice of the frame are
+/// deferred to the next frame, ahead of any newly queued ones. Fades stay on
+/// schedule, since their progress is computed from the current time when the
+/// update runs; a deferred update merely skips an intermediate value.
+///
+/// To bound the latency of low-priority blinkers under sustained load, a
+/// low-priority update that has been deferred 4 frames in a row goes ahead of
+/// the normal-priority ones; at most one per frame.
+///
+/// Attached blinkers must be destroyed before the frame scheduler.
+class FrameScheduler {
+ public:
+  /// Creates a frame scheduler on the default scheduler, with the specified
+  /// CPU budget per slice, and period of frames.
+  explicit FrameScheduler(roo_time::Duration budget = roo_time::Millis(2),
+                          roo_time::Duration period = roo_time::Millis(20));
+
+  /// Creates a frame scheduler on the specified scheduler, with the specified
+  /// CPU budget per slice, and period of frames.
+  FrameScheduler(roo_scheduler::Scheduler& scheduler,
+                 roo_time::Duration budget = roo_time::Millis(2),
+                 roo_time::Duration period = roo_time::Millis(20));
+
+  FrameScheduler(const FrameScheduler&) = delete;
+  FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+  /// Returns the scheduler that runs the frames, and the attached blinkers.
+  roo_scheduler::Scheduler& scheduler() { return scheduler_; }
+
+  /// Returns the statistics of frames run so far.
+  FrameStats stats() const;
+
+  /// Clears the statistics.
+  void resetStats();
+
+ private:
+  friend class internal::BlinkerCore;
+
+  // Number of frames a low-priority update can be deferred by, before it is
+  // promoted.
+  static constexpr uint32_t kMaxLowPriorityDeferrals = 4;
+
+  // Maximum number of slices that a frame is split into.
+  static constexpr uint8_t kSlicesPerFrame = 4;
+
+  // Singly-linked FIFO of blinkers with a pending update.
+  struct Queue {
+    internal::BlinkerCore* head = nullptr;
+    internal::BlinkerCore* tail = nullptr;
+  };
+
+  // Queues an update of the blinker in the next frame, unless already queued.
+  void request(internal::BlinkerCore* blinker);
+
+  // Removes the pending update of the blinker, if any.
+  void cancel(internal::BlinkerCore* blinker);
+
+  // Runs the next slice of the current frame, or starts a new frame.
+  void slice();
+
+  roo_scheduler::Scheduler& scheduler_;
+  roo_scheduler::SingletonTask task_;
+  roo_time::Duration budget_;
+  roo_time::Duration period_;
+
+  mutable roo::mutex mutex_;
+
+  // Indexed by FramePriority.
+  Queue queues_[2];
+
+  // Stamped on queued updates; frames process updates queued before they
+  // started.
+  uint32_t frame_id_;
+
+  // When the next slice is due, if scheduled.
+  roo_time::Uptime due_;
+
+  // When the current frame started, and the index of its next slice; zero
+  // when the next slice starts a new frame.
+  roo_time::Uptime frame_start_;
+  uint8_t slice_;
+
+  FrameStats stats_;
+};
+
+}  // namespace roo_blink
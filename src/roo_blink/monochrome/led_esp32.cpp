@@ -8,9 +8,6 @@
 namespace roo_blink {
 namespace esp32 {
 
-static constexpr ledc_timer_bit_t kDutyRes = LEDC_TIMER_10_BIT;
-static constexpr int kDuty = 1 << kDutyRes;
-
 static constexpr int kFreq = 40000;
 
 GpioLed::GpioLed(int gpio_num, Mode mode, ledc_timer_t timer_num,
@@ -36,11 +33,6 @@ GpioLed::GpioLed(int gpio_num, Mode mode, ledc_timer_t timer_num,
   ledc_fade_func_install(0);
 }
 
-void GpioLed::setLevel(uint16_t level) {
-  ledc_set_duty(LEDC_LOW_SPEED_MODE, channel_, dutyForLevel(level));
-  ledc_update_duty(LEDC_LOW_SPEED_MODE, channel_);
-}
-
 bool GpioLed::fade(uint16_t target_level, roo_time::Duration duration) {
   ESP_ERROR_CHECK(ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, channel_,
                                           dutyForLevel(target_level),
@@ -52,13 +44,6 @@ bool GpioLed::fade(uint16_t target_level, roo_time::Duration duration) {
   return true;
 }
 
-int GpioLed::dutyForLevel(uint16_t level) const {
-  if (mode_ == ON_LOW) {
-    level = 65535 - level;
-  }
-  return (uint32_t)level * kDuty / 65536;
-}
-
 #if CONFIG_IDF_TARGET_ESP32C3
 static const int kBuiltinLedPin = 8;
 static const GpioLed::Mode kBuiltinLedMode = GpioLed::ON_HIGH;
@@ -27,11 +27,23 @@ class GpioLed : public ::roo_blink::Led {
           ledc_timer_t timer_num = LEDC_TIMER_0,
           ledc_channel_t channel = LEDC_CHANNEL_0);
 
-  void setLevel(uint16_t level) override;
-  bool fade(uint16_t target_level, roo_time::Duration duration) override;
+  void setLevel(uint16_t level) final {
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, channel_, dutyForLevel(level));
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, channel_);
+  }
+
+  bool fade(uint16_t target_level, roo_time::Duration duration) final;
 
  private:
-  int dutyForLevel(uint16_t level) const;
+  static constexpr ledc_timer_bit_t kDutyRes = LEDC_TIMER_10_BIT;
+  static constexpr int kDuty = 1 << kDutyRes;
+
+  int dutyForLevel(uint16_t level) const {
+    if (mode_ == ON_LOW) {
+      level = 65535 - level;
+    }
+    return (uint32_t)level * kDuty / 65536;
+  }
 
   ledc_channel_t channel_;
   Mode mode_;
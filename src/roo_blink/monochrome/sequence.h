@@ -0,0 +1,71 @@
+#pragma once
+
+#include "roo_blink/core/sequence.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/source/step_source.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// Single step of a monochrome blink sequence.
+using Step = BasicStep<uint16_t>;
+
+/// Source of steps for streaming monochrome sequences.
+using BlinkSource = StepSource<Step>;
+
+/// Sequence of steps for monochrome blinking.
+using BlinkSequence = BasicSequence<uint16_t>;
+
+/// Creates a step that sets the LED to the maximum brightness instantly.
+constexpr Step TurnOn();
+
+/// Creates a step that sets the LED to completely off instantly.
+constexpr Step TurnOff();
+
+/// Creates a step that sets the LED to the specified brightness instantly.
+constexpr Step SetTo(uint16_t level);
+
+/// Creates a step that fades linearly to the target level over the duration.
+constexpr Step FadeTo(uint16_t level, roo_time::Duration duration);
+
+/// Creates a step that fades linearly to the maximum brightness over duration.
+constexpr Step FadeOn(roo_time::Duration duration);
+
+/// Creates a step that fades linearly down to off over the duration.
+constexpr Step FadeOff(roo_time::Duration duration);
+
+/// Creates a step that maintains the current brightness for the duration.
+constexpr Step Hold(roo_time::Duration duration);
+
+/// Creates a symmetric blink sequence with optional ramp-up/down segments.
+inline BlinkSequence Blink(roo_time::Duration period, int duty_percent = 50,
+                           int rampup_percent_on = 0,
+                           int rampup_percent_off = 0) {
+  return BasicBlink<uint16_t>(period, 65535, duty_percent, rampup_percent_on,
+                              rampup_percent_off);
+}
+
+// Implementation details.
+
+constexpr Step TurnOn() { return BasicSetTo<uint16_t>(65535); }
+constexpr Step TurnOff() { return BasicSetTo<uint16_t>(0); }
+
+constexpr Step SetTo(uint16_t level) { return BasicSetTo(level); }
+
+constexpr Step FadeTo(uint16_t level, roo_time::Duration duration) {
+  return BasicFadeTo(level, duration);
+}
+
+constexpr Step FadeOn(roo_time::Duration duration) {
+  return FadeTo(65535, duration);
+}
+
+constexpr Step FadeOff(roo_time::Duration duration) {
+  return FadeTo(0, duration);
+}
+
+constexpr Step Hold(roo_time::Duration duration) {
+  return BasicHold<uint16_t>(duration);
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,126 @@
+#include "roo_blink/pattern/codec.h"
+
+#include <string.h>
+
+namespace roo_blink {
+
+namespace {
+
+inline uint16_t ReadU16(const uint8_t* data) { return data[0] | (data[1] << 8); }
+
+inline void WriteU16(uint16_t value, uint8_t* data) {
+  data[0] = (uint8_t)value;
+  data[1] = (uint8_t)(value >> 8);
+}
+
+// The step count must not exceed kPatternMaxSteps.
+void WriteHeader(PatternKind kind, size_t step_count, uint8_t* out) {
+  memcpy(out, kPatternMagic, sizeof(kPatternMagic));
+  out[4] = kPatternVersion;
+  out[5] = (uint8_t)kind;
+  WriteU16((uint16_t)step_count, out + 6);
+}
+
+// Offset of the duration field in step records of the specified Value.
+template <typename Value>
+constexpr size_t DurationOffset() {
+  return 1 + ChannelTraits<Value>::kChannels *
+                 ChannelTraits<Value>::kChannelBytes;
+}
+
+}  // namespace
+
+template <typename Value>
+size_t EncodePattern(const BasicSequence<Value>& sequence, uint8_t* out,
+                     size_t capacity) {
+  size_t size = EncodedPatternSize(sequence);
+  if (size == 0 || size > capacity) return 0;
+  WriteHeader(ChannelTraits<Value>::kPatternKind, sequence.size(), out);
+  internal::PatternCodec::EncodeAll(sequence, out + kPatternHeaderSize);
+  return size;
+}
+
+template size_t EncodePattern(const BasicSequence<uint16_t>&, uint8_t*,
+                              size_t);
+template size_t EncodePattern(const BasicSequence<Color>&, uint8_t*, size_t);
+template size_t EncodePattern(const BasicSequence<RgbwColor>&, uint8_t*,
+                              size_t);
+template size_t EncodePattern(const BasicSequence<White>&, uint8_t*, size_t);
+
+namespace internal {
+
+template <typename Value>
+BasicStep<Value> PatternCodec::Decode(const uint8_t* record) {
+  using Traits = ChannelTraits<Value>;
+  using StepT = BasicStep<Value>;
+  static_assert(DurationOffset<Value>() + 2 ==
+                    PatternRecordSize(Traits::kPatternKind),
+                "Record size mismatch");
+  uint16_t channels[Traits::kChannels];
+  for (int i = 0; i < Traits::kChannels; ++i) {
+    channels[i] = Traits::kChannelBytes == 1
+                      ? record[1 + i]
+                      : ReadU16(record + 1 + 2 * i);
+  }
+  uint16_t duration = ReadU16(record + DurationOffset<Value>());
+  switch (record[0] & 0x0F) {
+    case kPatternOpSet:
+      return StepT(StepT::kSet, Traits::Join(channels), 0, 0);
+    case kPatternOpHold:
+      return StepT(StepT::kHold, Value(), duration, 0);
+    case kPatternOpFade:
+    default:
+      return StepT(StepT::kFade, Traits::Join(channels), duration,
+                   record[0] >> 4);
+  }
+}
+
+template <typename Value>
+void PatternCodec::Encode(const BasicStep<Value>& step, uint8_t* record) {
+  using Traits = ChannelTraits<Value>;
+  using StepT = BasicStep<Value>;
+  switch (step.type_) {
+    case StepT::kSet:
+      record[0] = kPatternOpSet;
+      break;
+    case StepT::kHold:
+      record[0] = kPatternOpHold;
+      break;
+    case StepT::kFade:
+    default:
+      record[0] = kPatternOpFade;
+      if (PatternHasInterpolation(Traits::kPatternKind)) {
+        record[0] |= step.interpolation_ << 4;
+      }
+      break;
+  }
+  uint16_t channels[Traits::kChannels];
+  Traits::Split(step.target_, channels);
+  for (int i = 0; i < Traits::kChannels; ++i) {
+    if (Traits::kChannelBytes == 1) {
+      record[1 + i] = (uint8_t)channels[i];
+    } else {
+      WriteU16(channels[i], record + 1 + 2 * i);
+    }
+  }
+  WriteU16(step.duration_millis_, record + DurationOffset<Value>());
+}
+
+template <typename Value>
+void PatternCodec::EncodeAll(const BasicSequence<Value>& sequence,
+                             uint8_t* records) {
+  for (size_t i = 0; i < sequence.size(); ++i) {
+    Encode(sequence.stepAt(i), records);
+    records += PatternRecordSize(ChannelTraits<Value>::kPatternKind);
+  }
+}
+
+template BasicStep<uint16_t> PatternCodec::Decode<uint16_t>(const uint8_t*);
+template BasicStep<Color> PatternCodec::Decode<Color>(const uint8_t*);
+template BasicStep<RgbwColor> PatternCodec::Decode<RgbwColor>(
+    const uint8_t*);
+template BasicStep<White> PatternCodec::Decode<White>(const uint8_t*);
+
+}  // namespace internal
+
+}  // namespace roo_blink
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include "roo_blink/core/channels.h"
+#include "roo_blink/core/sequence.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/pattern/format.h"
+
+namespace roo_blink {
+
+/// Returns the size, in bytes, of the encoded form of the sequence, or zero
+/// if the sequence can't be encoded, because it was created with
+/// FromSource(), or has more than kPatternMaxSteps steps.
+template <typename Value>
+size_t EncodedPatternSize(const BasicSequence<Value>& sequence) {
+  if (sequence.hasSource() || sequence.size() > kPatternMaxSteps) return 0;
+  return kPatternHeaderSize +
+         sequence.size() *
+             PatternRecordSize(ChannelTraits<Value>::kPatternKind);
+}
+
+/// Encodes the sequence into `out`. Returns the number of bytes written, or
+/// zero if `capacity` is insufficient, or if the sequence can't be encoded
+/// (see EncodedPatternSize()).
+template <typename Value>
+size_t EncodePattern(const BasicSequence<Value>& sequence, uint8_t* out,
+                     size_t capacity);
+
+/// Returns the encoded form of the sequence; empty if the sequence can't be
+/// encoded (see EncodedPatternSize()).
+template <typename Value>
+std::vector<uint8_t> EncodePattern(const BasicSequence<Value>& sequence) {
+  std::vector<uint8_t> result(EncodedPatternSize(sequence));
+  EncodePattern(sequence, result.data(), result.size());
+  return result;
+}
+
+namespace internal {
+
+// Converts between steps and their fixed-size pattern records. Records hold
+// the opcode, the channels (as per ChannelTraits), and the duration.
+class PatternCodec {
+ public:
+  template <typename Value>
+  static BasicStep<Value> Decode(const uint8_t* record);
+
+  template <typename Value>
+  static void Encode(const BasicStep<Value>& step, uint8_t* record);
+
+  // Encodes all steps of the (non-source) sequence, as consecutive records.
+  template <typename Value>
+  static void EncodeAll(const BasicSequence<Value>& sequence,
+                        uint8_t* records);
+};
+
+}  // namespace internal
+
+}  // namespace roo_blink
@@ -0,0 +1,56 @@
+#include "roo_blink/pattern/format.h"
+
+#include <string.h>
+
+#include "roo_blink/rgb/interpolation.h"
+
+namespace roo_blink {
+
+const char* PatternStatusName(PatternStatus status) {
+  switch (status) {
+    case PatternStatus::kOk:
+      return "OK";
+    case PatternStatus::kTruncated:
+      return "truncated";
+    case PatternStatus::kBadMagic:
+      return "bad magic";
+    case PatternStatus::kUnsupportedVersion:
+      return "unsupported version";
+    case PatternStatus::kUnknownKind:
+      return "unknown kind";
+    case PatternStatus::kBadStep:
+    default:
+      return "bad step";
+  }
+}
+
+PatternStatus ValidatePattern(const uint8_t* data, size_t size) {
+  if (size < kPatternHeaderSize) return PatternStatus::kTruncated;
+  if (memcmp(data, kPatternMagic, sizeof(kPatternMagic)) != 0) {
+    return PatternStatus::kBadMagic;
+  }
+  if (data[4] != kPatternVersion) return PatternStatus::kUnsupportedVersion;
+  if (data[5] > (uint8_t)PatternKind::kWhite) {
+    return PatternStatus::kUnknownKind;
+  }
+  if (size < PatternSize(data)) return PatternStatus::kTruncated;
+  PatternKind kind = PatternKindOf(data);
+  size_t record_size = PatternRecordSize(kind);
+  const uint8_t* record = data + kPatternHeaderSize;
+  for (uint16_t i = 0; i < PatternStepCount(data); ++i) {
+    uint8_t opcode = record[0] & 0x0F;
+    uint8_t flags = record[0] >> 4;
+    if (opcode > kPatternOpFade) return PatternStatus::kBadStep;
+    if (PatternHasInterpolation(kind) && opcode == kPatternOpFade) {
+      if (flags > (uint8_t)RgbInterpolation::kHsv) {
+        return PatternStatus::kBadStep;
+      }
+    } else if (flags != 0) {
+      return PatternStatus::kBadStep;
+    }
+    record += record_size;
+  }
+  return PatternStatus::kOk;
+}
+
+}  // namespace roo_blink
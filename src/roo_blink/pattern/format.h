@@ -0,0 +1,107 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Compact, versioned binary encoding of blink sequences ("patterns").
+///
+/// A pattern can be played directly from memory (e.g. a flash partition, a
+/// constant array, or a memory-mapped file), with no copying and no per-step
+/// heap allocation. See BasicSequence::FromPattern(). Use EncodePattern() (in
+/// roo_blink/pattern/codec.h) to produce patterns.
+///
+/// Layout (multi-byte integers are little-endian):
+///
+///   offset  size  field
+///   0       4     magic: 'R', 'B', 'L', 'K'
+///   4       1     format version (kPatternVersion)
+///   5       1     kind (PatternKind)
+///   6       2     step count
+///   8       ...   step records, of a fixed size determined by the kind
+///
+/// Monochrome step record (5 bytes): opcode, level (2), duration in ms (2).
+/// RGB step record (6 bytes): opcode, red, green, blue, duration in ms (2).
+/// RGBW step record (7 bytes): opcode, red, green, blue, white, duration in
+/// ms (2).
+/// Tunable-white step record (7 bytes): opcode, warm level (2), cool level
+/// (2), duration in ms (2).
+///
+/// The low nibble of the opcode byte holds the step type (PatternOpcode). For
+/// RGB fade steps, the high nibble holds the RgbInterpolation; otherwise, it
+/// is reserved, and must be zero.
+
+namespace roo_blink {
+
+static constexpr uint8_t kPatternMagic[4] = {'R', 'B', 'L', 'K'};
+static constexpr uint8_t kPatternVersion = 1;
+static constexpr size_t kPatternHeaderSize = 8;
+
+/// Maximum number of steps in a pattern, as limited by the step count field.
+static constexpr size_t kPatternMaxSteps = 65535;
+
+/// Type of steps stored in a pattern.
+enum class PatternKind : uint8_t {
+  kMonochrome = 0,
+  kRgb = 1,
+  kRgbw = 2,
+  kWhite = 3,
+};
+
+/// Step types, as stored in the low nibble of the record's opcode byte.
+enum PatternOpcode : uint8_t {
+  kPatternOpSet = 0,
+  kPatternOpHold = 1,
+  kPatternOpFade = 2,
+};
+
+/// Result of pattern validation.
+enum class PatternStatus {
+  kOk = 0,
+  kTruncated,
+  kBadMagic,
+  kUnsupportedVersion,
+  kUnknownKind,
+  kBadStep,
+};
+
+/// Returns a human-readable name of the status.
+const char* PatternStatusName(PatternStatus status);
+
+/// Returns the size of a single step record, for the given kind.
+constexpr size_t PatternRecordSize(PatternKind kind) {
+  return kind == PatternKind::kMonochrome ? 5
+         : kind == PatternKind::kRgb      ? 6
+                                          : 7;
+}
+
+/// Returns true if fade records of the given kind carry an interpolation
+/// mode, in the high nibble of the opcode byte. It must be zero otherwise.
+constexpr bool PatternHasInterpolation(PatternKind kind) {
+  return kind == PatternKind::kRgb;
+}
+
+/// Checks whether `data` holds a well-formed pattern, no larger than `size`.
+/// Bytes past the end of the pattern are ignored, so `size` may be e.g. the
+/// size of the containing flash partition.
+///
+/// Patterns from untrusted sources (e.g. downloaded) should be validated
+/// before being passed to FromPattern().
+PatternStatus ValidatePattern(const uint8_t* data, size_t size);
+
+/// Returns the kind of the (valid) pattern.
+inline PatternKind PatternKindOf(const uint8_t* data) {
+  return (PatternKind)data[5];
+}
+
+/// Returns the step count of the (valid) pattern.
+inline uint16_t PatternStepCount(const uint8_t* data) {
+  return data[6] | (data[7] << 8);
+}
+
+/// Returns the total encoded size, in bytes, of the (valid) pattern.
+inline size_t PatternSize(const uint8_t* data) {
+  return kPatternHeaderSize +
+         PatternStepCount(data) * PatternRecordSize(PatternKindOf(data));
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,87 @@
+#include "roo_blink/playback.h"
+
+namespace roo_blink {
+namespace internal {
+
+PlaybackState::PlaybackState(PlaybackOwner* owner)
+    : status_(PlaybackStatus::kPending), owner_(owner) {}
+
+void PlaybackState::finish(PlaybackStatus status) {
+  std::function<void(PlaybackStatus)> callback;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    if (status_ != PlaybackStatus::kPending) return;
+    status_ = status;
+    owner_ = nullptr;
+    callback = std::move(callback_);
+    callback_ = nullptr;
+    done_.notify_all();
+  }
+  if (callback != nullptr) callback(status);
+}
+
+PlaybackStatus PlaybackState::status() const {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  return status_;
+}
+
+bool PlaybackState::wait(roo_time::Uptime deadline) {
+  roo::unique_lock<roo::mutex> lock(mutex_);
+  while (status_ == PlaybackStatus::kPending) {
+    if (done_.wait_until(lock, deadline) == roo::cv_status::timeout) {
+      return status_ != PlaybackStatus::kPending;
+    }
+  }
+  return true;
+}
+
+void PlaybackState::onDone(std::function<void(PlaybackStatus)> callback) {
+  PlaybackStatus status;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    if (status_ == PlaybackStatus::kPending) {
+      callback_ = std::move(callback);
+      return;
+    }
+    status = status_;
+  }
+  callback(status);
+}
+
+void PlaybackState::cancel() {
+  PlaybackOwner* owner;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    owner = owner_;
+  }
+  if (owner != nullptr) owner->cancelPlayback(this);
+}
+
+}  // namespace internal
+
+PlaybackStatus Playback::status() const {
+  return state_ == nullptr ? PlaybackStatus::kCompleted : state_->status();
+}
+
+bool Playback::wait(roo_time::Duration timeout) const {
+  return state_ == nullptr || state_->wait(roo_time::Uptime::Now() + timeout);
+}
+
+void Playback::wait() const {
+  while (!wait(roo_time::Seconds(3600))) {
+  }
+}
+
+void Playback::onDone(std::function<void(PlaybackStatus)> callback) {
+  if (state_ == nullptr) {
+    callback(PlaybackStatus::kCompleted);
+  } else {
+    state_->onDone(std::move(callback));
+  }
+}
+
+void Playback::cancel() {
+  if (state_ != nullptr) state_->cancel();
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "roo_threads.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// State of a sequence started with Blinker::execute(), repeat(), or loop()
+/// (and their counterparts in other blinkers).
+enum class PlaybackStatus {
+  /// The sequence is still playing.
+  kPending,
+
+  /// The sequence finished, and the terminal level (or color) was applied.
+  kCompleted,
+
+  /// The sequence was stopped via Playback::cancel(), or because the blinker
+  /// was destroyed.
+  kCancelled,
+
+  /// The sequence was replaced by another one, before it finished.
+  kSuperseded,
+};
+
+namespace internal {
+
+class BlinkerCore;
+class PlaybackState;
+
+// Implemented by blinkers, to support cancellation of their playbacks.
+class PlaybackOwner {
+ public:
+  // Stops the playback, if it is still the current one.
+  virtual void cancelPlayback(PlaybackState* state) = 0;
+
+ protected:
+  ~PlaybackOwner() = default;
+};
+
+// Completion state shared between a blinker and Playback handles.
+class PlaybackState {
+ public:
+  explicit PlaybackState(PlaybackOwner* owner);
+
+  // Sets the final status, wakes up waiters, and invokes the callback. Has no
+  // effect if already finished.
+  void finish(PlaybackStatus status);
+
+  PlaybackStatus status() const;
+  bool wait(roo_time::Uptime deadline);
+  void onDone(std::function<void(PlaybackStatus)> callback);
+  void cancel();
+
+ private:
+  mutable roo::mutex mutex_;
+  roo::condition_variable done_;
+  PlaybackStatus status_;
+
+  // Cleared when the playback finishes.
+  PlaybackOwner* owner_;
+  std::function<void(PlaybackStatus)> callback_;
+};
+
+}  // namespace internal
+
+/// Lightweight handle to a playing sequence. Can be copied; all copies refer
+/// to the same playback. Handles may outlive the blinker; destroying the
+/// blinker cancels its pending playback.
+///
+/// Completion is signaled by the blinker from its scheduler thread as soon as
+/// the sequence finishes, so no polling is involved.
+class Playback {
+ public:
+  /// Creates an empty handle, which reports as completed.
+  Playback() = default;
+
+  /// Returns the current status of the playback.
+  PlaybackStatus status() const;
+
+  /// Returns true if the playback is no longer pending.
+  bool done() const { return status() != PlaybackStatus::kPending; }
+
+  /// Blocks until the playback is done, or until the timeout elapses. Returns
+  /// true if the playback is done. Must not be called from the blinker's
+  /// scheduler thread.
+  bool wait(roo_time::Duration timeout) const;
+
+  /// Blocks until the playback is done. Must not be called from the blinker's
+  /// scheduler thread. Never returns for loop() playbacks that are not
+  /// cancelled or superseded.
+  void wait() const;
+
+  /// Registers the callback to be invoked when the playback is done. The
+  /// callback runs on the thread that finishes the playback: the blinker's
+  /// scheduler thread on completion, or the thread that cancels or
+  /// supersedes the playback. If the playback is already done, the callback is
+  /// invoked immediately. Replaces the previously registered callback, if any.
+  ///
+  /// The callback may start another sequence on the same blinker, except
+  /// when invoked because the blinker is being destroyed.
+  void onDone(std::function<void(PlaybackStatus)> callback);
+
+  /// Stops the playback, if it is still pending, applying the terminal level
+  /// (or color). Has no effect otherwise.
+  void cancel();
+
+ private:
+  friend class internal::BlinkerCore;
+
+  explicit Playback(std::shared_ptr<internal::PlaybackState> state)
+      : state_(std::move(state)) {}
+
+  std::shared_ptr<internal::PlaybackState> state_;
+};
+
+}  // namespace roo_blink
@@ -8,19 +8,23 @@ namespace roo_blink {
 /// RGB LED backed by an Adafruit_NeoPixel instance.
 class NeoPixelLed : public RgbLed {
  public:
-  /// Creates a wrapper for a specific NeoPixel index.
-  NeoPixelLed(Adafruit_NeoPixel& neopixel, int led_idx = 0)
-      : neopixel_(neopixel), led_idx_(led_idx) {}
+  /// Creates a wrapper for a specific NeoPixel index. If `show` is false,
+  /// color changes only update the pixel buffer, and the caller is
+  /// responsible for calling show() on the strip (e.g. in
+  /// PowerBudget::onFlush()).
+  NeoPixelLed(Adafruit_NeoPixel& neopixel, int led_idx = 0, bool show = true)
+      : neopixel_(neopixel), led_idx_(led_idx), show_(show) {}
 
-  /// Sets the color and immediately updates the strip.
-  void setColor(Color color) override {
+  /// Sets the color and, unless disabled, immediately updates the strip.
+  void setColor(Color color) final {
     neopixel_.setPixelColor(led_idx_, color.r(), color.g(), color.b());
-    neopixel_.show();
+    if (show_) neopixel_.show();
   }
 
  private:
   Adafruit_NeoPixel& neopixel_;
   int led_idx_;
+  bool show_;
 };
 
 }  // namespace roo_blink
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "roo_blink/rgb/color.h"
+
+namespace roo_blink {
+
+/// Color space in which RGB fades are interpolated.
+enum class RgbInterpolation : uint8_t {
+  /// Linear interpolation of the raw (gamma-encoded) sRGB components. The
+  /// cheapest, but fades between distinct hues pass through darker, muddy
+  /// colors (e.g. red to green goes through dark brown).
+  kRaw = 0,
+
+  /// Linear interpolation in linear-light RGB. Keeps perceived brightness
+  /// steady across the fade.
+  kGammaLinear = 1,
+
+  /// Interpolation in HSV, along the shorter way around the hue wheel. Keeps
+  /// colors saturated (e.g. red to green goes through yellow).
+  kHsv = 2,
+};
+
+namespace internal {
+
+// Interpolates between two colors in the chosen color space. Endpoints are
+// converted to the interpolation space once, when the fade starts; each
+// subsequent call uses only integer arithmetic and table lookups.
+class ColorFade {
+ public:
+  ColorFade() : interpolation_(RgbInterpolation::kRaw), from_(), to_() {}
+
+  // Prepares the fade between the specified colors.
+  void start(Color from, Color to, RgbInterpolation interpolation);
+
+  // As above, with the interpolation given as stored in steps.
+  void start(Color from, Color to, uint8_t interpolation) {
+    start(from, to, (RgbInterpolation)interpolation);
+  }
+
+  // Returns the color at the specified progress, with 65536 corresponding to
+  // the end of the fade.
+  Color at(uint32_t progress) const;
+
+ private:
+  RgbInterpolation interpolation_;
+
+  // Endpoints in the interpolation space: (r, g, b) for kRaw (0-255) and
+  // kGammaLinear (0-65535, stored as unsigned), or (h, s, v) for kHsv, with
+  // the hue (0-1535) of `to_` unwrapped to be within half a turn of `from_`.
+  int32_t from_[3];
+  int32_t to_[3];
+};
+
+}  // namespace internal
+}  // namespace roo_blink
@@ -0,0 +1,165 @@
+#include "roo_blink/rgb/power_budget.h"
+
+#include "roo_blink/default_scheduler.h"
+
+namespace roo_blink {
+
+namespace {
+
+inline uint32_t Load(Color color) { return color.r() + color.g() + color.b(); }
+
+// Returns the margin, of about 3%, that the scale factor keeps below the
+// budget, and the minimum relative change for it to go up.
+inline uint16_t ScaleMargin(uint16_t scale) { return scale / 32; }
+
+}  // namespace
+
+PowerBudget::PowerBudget(uint32_t budget_ma, uint16_t channel_ma,
+                         uint16_t idle_ma)
+    : PowerBudget(DefaultScheduler(), budget_ma, channel_ma, idle_ma) {}
+
+PowerBudget::PowerBudget(roo_scheduler::Scheduler& scheduler,
+                         uint32_t budget_ma, uint16_t channel_ma,
+                         uint16_t idle_ma)
+    : flusher_(scheduler, [this]() { flush(); }),
+      budget_ma_(budget_ma),
+      channel_ma_(channel_ma),
+      idle_ma_(idle_ma),
+      load_(0),
+      led_count_(0),
+      scale_(256),
+      head_(nullptr),
+      dirty_head_(nullptr) {}
+
+uint32_t PowerBudget::requestedCurrentMa() const {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  return (uint32_t)idle_ma_ * led_count_ +
+         (uint64_t)load_ * channel_ma_ / 255;
+}
+
+uint16_t PowerBudget::scale() const {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  return scale_;
+}
+
+void PowerBudget::onFlush(std::function<void()> callback) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  on_flush_ = std::move(callback);
+}
+
+void PowerBudget::attach(PowerLimitedLed* led) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  led->next_ = head_;
+  head_ = led;
+  ++led_count_;
+  // The idle current may have pushed the total over budget.
+  requestFlush();
+}
+
+void PowerBudget::detach(PowerLimitedLed* led) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  PowerLimitedLed** ptr = &head_;
+  while (*ptr != led) ptr = &(*ptr)->next_;
+  *ptr = led->next_;
+  if (led->dirty_) {
+    ptr = &dirty_head_;
+    while (*ptr != led) ptr = &(*ptr)->dirty_next_;
+    *ptr = led->dirty_next_;
+  }
+  --led_count_;
+  load_ -= Load(led->requested_);
+  requestFlush();
+}
+
+void PowerBudget::update(PowerLimitedLed* led, Color color) {
+  roo::lock_guard<roo::mutex> lock(mutex_);
+  load_ = load_ - Load(led->requested_) + Load(color);
+  led->requested_ = color;
+  if (!led->dirty_) {
+    led->dirty_ = true;
+    led->dirty_next_ = dirty_head_;
+    dirty_head_ = led;
+  }
+  requestFlush();
+}
+
+void PowerBudget::requestFlush() {
+  if (!flusher_.is_scheduled()) {
+    flusher_.scheduleAfter(roo_time::Millis(kFramePeriodMillis),
+                           roo_scheduler::PRIORITY_ELEVATED);
+  }
+}
+
+void PowerBudget::flush() {
+  std::function<void()> on_flush;
+  {
+    roo::lock_guard<roo::mutex> lock(mutex_);
+    bool written = (dirty_head_ != nullptr);
+    if (updateScale()) {
+      for (PowerLimitedLed* led = head_; led != nullptr; led = led->next_) {
+        led->led_.setColor(scaled(led->requested_));
+      }
+      written = (head_ != nullptr);
+    } else {
+      for (PowerLimitedLed* led = dirty_head_; led != nullptr;
+           led = led->dirty_next_) {
+        led->led_.setColor(scaled(led->requested_));
+      }
+    }
+    while (dirty_head_ != nullptr) {
+      dirty_head_->dirty_ = false;
+      dirty_head_ = dirty_head_->dirty_next_;
+    }
+    if (!written) return;
+    on_flush = on_flush_;
+  }
+  if (on_flush) on_flush();
+}
+
+bool PowerBudget::updateScale() {
+  uint16_t target = 256;
+  uint64_t load_ma = (uint64_t)load_ * channel_ma_;
+  uint32_t idle_ma = (uint32_t)idle_ma_ * led_count_;
+  if (idle_ma >= budget_ma_) {
+    target = 0;
+  } else if (idle_ma + load_ma / 255 > budget_ma_) {
+    target = (uint64_t)(budget_ma_ - idle_ma) * 255 * 256 / load_ma;
+  }
+  if (target == 256) {
+    // Within budget.
+    if (scale_ == 256) return false;
+    scale_ = 256;
+    return true;
+  }
+  // Leaves a margin, so that a slowly growing load does not require
+  // rescaling in every frame.
+  uint16_t scale = target - ScaleMargin(target);
+  if (target >= scale_ && scale <= scale_ + ScaleMargin(scale_)) {
+    // Still within budget, and the load has not dropped noticeably.
+    return false;
+  }
+  scale_ = scale;
+  return true;
+}
+
+Color PowerBudget::scaled(Color color) const {
+  if (scale_ == 256) return color;
+  return Color((color.r() * scale_) >> 8, (color.g() * scale_) >> 8,
+               (color.b() * scale_) >> 8);
+}
+
+PowerLimitedLed::PowerLimitedLed(RgbLed& led, PowerBudget& budget)
+    : led_(led),
+      budget_(budget),
+      requested_(),
+      next_(nullptr),
+      dirty_(false),
+      dirty_next_(nullptr) {
+  budget_.attach(this);
+}
+
+PowerLimitedLed::~PowerLimitedLed() { budget_.detach(this); }
+
+void PowerLimitedLed::setColor(Color color) { budget_.update(this, color); }
+
+}  // namespace roo_blink
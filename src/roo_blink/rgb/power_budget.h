@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+
+#include "roo_blink/rgb/color.h"
+#include "roo_blink/rgb/led.h"
+#include "roo_scheduler.h"
+#include "roo_threads.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+class PowerLimitedLed;
+
+/// Current budget shared by RGB LEDs that draw from the same power supply.
+///
+/// Keeps a running estimate of the total current requested by all attached
+/// LEDs (see PowerLimitedLed), and when it exceeds the budget, scales all
+/// colors down proportionally, so that the supply does not brown out.
+///
+/// Color changes are not written through immediately. The estimate is updated
+/// in O(1), and the LED is marked dirty; the changes are applied once per
+/// frame, by flush(), which runs automatically one frame period after the
+/// first change. A flush writes only the dirty LEDs, unless the scale factor
+/// changes, in which case it rewrites all attached LEDs. The scale factor has
+/// some hysteresis, and keeps a little headroom below the budget, so that
+/// small load changes (e.g. fades) don't cause rewrites every frame.
+///
+/// For strips that are refreshed as a whole (e.g. Adafruit_NeoPixel), wrap
+/// LEDs that don't refresh the strip on each write, and refresh it once per
+/// flush, in onFlush().
+class PowerBudget {
+ public:
+  /// Creates a budget of `budget_ma` milliamps, flushed on the default
+  /// scheduler. Each LED is assumed to draw `channel_ma` per color channel at
+  /// full intensity (about 20 mA for the WS2812), proportionally less at
+  /// lower intensities, plus `idle_ma` regardless of the color.
+  PowerBudget(uint32_t budget_ma, uint16_t channel_ma = 20,
+              uint16_t idle_ma = 1);
+
+  /// Same as above, flushed on the specified scheduler.
+  PowerBudget(roo_scheduler::Scheduler& scheduler, uint32_t budget_ma,
+              uint16_t channel_ma = 20, uint16_t idle_ma = 1);
+
+  /// Returns the estimated current, in milliamps, that the attached LEDs would
+  /// draw without limiting.
+  uint32_t requestedCurrentMa() const;
+
+  /// Returns the scale factor currently applied to colors, from 0 to 256,
+  /// with 256 meaning no limiting.
+  uint16_t scale() const;
+
+  /// Writes the pending color changes to the LEDs, rescaling all of them if
+  /// needed. Called automatically, once per frame, while there are pending
+  /// changes; may be called directly to apply them immediately.
+  void flush();
+
+  /// Sets a function to call after each flush that has written any LED, e.g.
+  /// to refresh the strip.
+  void onFlush(std::function<void()> callback);
+
+ private:
+  friend class PowerLimitedLed;
+
+  // Interval between automatic flushes.
+  static constexpr uint16_t kFramePeriodMillis = 20;
+
+  void attach(PowerLimitedLed* led);
+  void detach(PowerLimitedLed* led);
+  void update(PowerLimitedLed* led, Color color);
+
+  // Schedules a flush in the next frame, unless already scheduled.
+  void requestFlush();
+
+  // Recalculates scale_ from load_. Returns true if it has changed.
+  bool updateScale();
+
+  Color scaled(Color color) const;
+
+  roo_scheduler::SingletonTask flusher_;
+
+  mutable roo::mutex mutex_;
+  uint32_t budget_ma_;
+  uint16_t channel_ma_;
+  uint16_t idle_ma_;
+
+  // Sum of the requested color components of all attached LEDs.
+  uint32_t load_;
+  uint16_t led_count_;
+  uint16_t scale_;
+
+  // Attached LEDs, as an intrusive list.
+  PowerLimitedLed* head_;
+
+  // LEDs whose color has changed since the last flush, as an intrusive list.
+  PowerLimitedLed* dirty_head_;
+
+  std::function<void()> on_flush_;
+};
+
+/// RGB LED that accounts for its color in a PowerBudget, and gets dimmed if
+/// the budget is exceeded. Wrap each LED (e.g. each NeoPixelLed of a strip)
+/// that draws from the supply, and pass the wrappers to the blinkers.
+class PowerLimitedLed final : public RgbLed {
+ public:
+  /// Wraps the specified LED, attaching it to the budget. The LED starts as
+  /// black.
+  PowerLimitedLed(RgbLed& led, PowerBudget& budget);
+
+  ~PowerLimitedLed();
+
+  PowerLimitedLed(const PowerLimitedLed&) = delete;
+  PowerLimitedLed& operator=(const PowerLimitedLed&) = delete;
+
+  /// Sets the requested color. It gets written (possibly dimmed) to the LED in
+  /// the next flush of the budget.
+  void setColor(Color color) override;
+
+ private:
+  friend class PowerBudget;
+
+  RgbLed& led_;
+  PowerBudget& budget_;
+  Color requested_;
+  PowerLimitedLed* next_;
+
+  bool dirty_;
+  PowerLimitedLed* dirty_next_;
+};
+
+}  // namespace roo_blink
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "roo_blink/core/sequence.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/rgb/color.h"
+#include "roo_blink/rgb/interpolation.h"
+#include "roo_blink/source/step_source.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// Single step of an RGB blink sequence.
+using RgbStep = BasicStep<Color>;
+
+/// Source of steps for streaming RGB sequences.
+using RgbBlinkSource = StepSource<RgbStep>;
+
+/// Sequence of steps for RGB blinking.
+using RgbBlinkSequence = BasicSequence<Color>;
+
+/// Creates a step that sets the LED to the specified color instantly.
+constexpr RgbStep RgbSetTo(Color color);
+
+/// Creates a step that disables the LED. Equivalent to RgbSetTo(Color()).
+constexpr RgbStep RgbTurnOff();
+
+/// Creates a step that fades to the target color over the duration,
+/// interpolating in the specified color space.
+constexpr RgbStep RgbFadeTo(
+    Color color, roo_time::Duration duration,
+    RgbInterpolation interpolation = RgbInterpolation::kRaw);
+
+/// Creates a step that fades the LED off over the duration, interpolating in
+/// the specified color space.
+constexpr RgbStep RgbFadeOff(
+    roo_time::Duration duration,
+    RgbInterpolation interpolation = RgbInterpolation::kRaw);
+
+/// Creates a step that holds the current color for the duration.
+constexpr RgbStep RgbHold(roo_time::Duration duration);
+
+/// Creates a symmetric blink sequence with optional ramp-up/down segments.
+inline RgbBlinkSequence RgbBlink(roo_time::Duration period, Color color,
+                                 int duty_percent = 50,
+                                 int rampup_percent_on = 0,
+                                 int rampup_percent_off = 0) {
+  return BasicBlink(period, color, duty_percent, rampup_percent_on,
+                    rampup_percent_off);
+}
+
+// Implementation details.
+
+constexpr RgbStep RgbSetTo(Color color) { return BasicSetTo(color); }
+
+constexpr RgbStep RgbTurnOff() { return RgbSetTo(Color()); }
+
+constexpr RgbStep RgbHold(roo_time::Duration duration) {
+  return BasicHold<Color>(duration);
+}
+
+constexpr RgbStep RgbFadeTo(Color color, roo_time::Duration duration,
+                            RgbInterpolation interpolation) {
+  return BasicFadeTo(color, duration, (uint8_t)interpolation);
+}
+
+constexpr RgbStep RgbFadeOff(roo_time::Duration duration,
+                             RgbInterpolation interpolation) {
+  return RgbFadeTo(Color(), duration, interpolation);
+}
+
+}  // namespace roo_blink
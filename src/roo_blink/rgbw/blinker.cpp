@@ -0,0 +1,7 @@
+#include "roo_blink/rgbw/blinker.h"
+
+namespace roo_blink {
+
+template class BlinkEngine<RgbwColor, RgbwLed>;
+
+}  // namespace roo_blink
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "roo_blink/core/engine.h"
+#include "roo_blink/rgbw/led.h"
+#include "roo_blink/rgbw/sequence.h"
+
+namespace roo_blink {
+
+/// Runs blink sequences on an RGBW LED of type LedT, which needs to provide
+/// setColor(RgbwColor), as in RgbwLed.
+template <typename LedT>
+using BasicRgbwBlinker = BlinkEngine<RgbwColor, LedT>;
+
+/// Runs blink sequences on an RGBW LED. Accepts any RgbwLed implementation.
+using RgbwBlinker = BasicRgbwBlinker<RgbwLed>;
+
+extern template class BlinkEngine<RgbwColor, RgbwLed>;
+
+}  // namespace roo_blink
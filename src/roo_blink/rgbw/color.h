@@ -0,0 +1,30 @@
+#pragma once
+
+#include <inttypes.h>
+
+namespace roo_blink {
+
+/// 32-bit RGBW color value, for LEDs with a dedicated white emitter.
+class RgbwColor {
+ public:
+  /// Creates black (all emitters off).
+  constexpr RgbwColor() : rgbw_(0) {}
+
+  /// Creates a color from 8-bit red, green, blue, and white components.
+  constexpr RgbwColor(uint8_t r, uint8_t g, uint8_t b, uint8_t w)
+      : rgbw_(((uint32_t)r << 24) | ((uint32_t)g << 16) | (b << 8) | w) {}
+
+  /// Returns the red component.
+  uint8_t r() const { return (uint8_t)(rgbw_ >> 24); }
+  /// Returns the green component.
+  uint8_t g() const { return (uint8_t)(rgbw_ >> 16); }
+  /// Returns the blue component.
+  uint8_t b() const { return (uint8_t)(rgbw_ >> 8); }
+  /// Returns the white component.
+  uint8_t w() const { return (uint8_t)(rgbw_ >> 0); }
+
+ private:
+  uint32_t rgbw_;
+};
+
+}  // namespace roo_blink
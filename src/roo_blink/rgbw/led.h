@@ -0,0 +1,15 @@
+#pragma once
+
+#include "roo_blink/rgbw/color.h"
+#include "stdint.h"
+
+namespace roo_blink {
+
+/// Abstract interface representing an RGBW LED.
+class RgbwLed {
+ public:
+  /// Sets the LED to the specified color.
+  virtual void setColor(RgbwColor color) = 0;
+};
+
+}  // namespace roo_blink
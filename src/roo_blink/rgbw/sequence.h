@@ -0,0 +1,63 @@
+#pragma once
+
+#include "roo_blink/core/sequence.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/rgbw/color.h"
+#include "roo_blink/source/step_source.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// Single step of an RGBW blink sequence.
+using RgbwStep = BasicStep<RgbwColor>;
+
+/// Source of steps for streaming RGBW sequences.
+using RgbwBlinkSource = StepSource<RgbwStep>;
+
+/// Sequence of steps for RGBW blinking.
+using RgbwBlinkSequence = BasicSequence<RgbwColor>;
+
+/// Creates a step that sets the LED to the specified color instantly.
+constexpr RgbwStep RgbwSetTo(RgbwColor color);
+
+/// Creates a step that disables the LED. Equivalent to RgbwSetTo(RgbwColor()).
+constexpr RgbwStep RgbwTurnOff();
+
+/// Creates a step that fades linearly, per emitter, to the target color over
+/// the duration.
+constexpr RgbwStep RgbwFadeTo(RgbwColor color, roo_time::Duration duration);
+
+/// Creates a step that fades the LED off over the duration.
+constexpr RgbwStep RgbwFadeOff(roo_time::Duration duration);
+
+/// Creates a step that holds the current color for the duration.
+constexpr RgbwStep RgbwHold(roo_time::Duration duration);
+
+/// Creates a symmetric blink sequence with optional ramp-up/down segments.
+inline RgbwBlinkSequence RgbwBlink(roo_time::Duration period, RgbwColor color,
+                                   int duty_percent = 50,
+                                   int rampup_percent_on = 0,
+                                   int rampup_percent_off = 0) {
+  return BasicBlink(period, color, duty_percent, rampup_percent_on,
+                    rampup_percent_off);
+}
+
+// Implementation details.
+
+constexpr RgbwStep RgbwSetTo(RgbwColor color) { return BasicSetTo(color); }
+
+constexpr RgbwStep RgbwTurnOff() { return RgbwSetTo(RgbwColor()); }
+
+constexpr RgbwStep RgbwFadeTo(RgbwColor color, roo_time::Duration duration) {
+  return BasicFadeTo(color, duration);
+}
+
+constexpr RgbwStep RgbwFadeOff(roo_time::Duration duration) {
+  return RgbwFadeTo(RgbwColor(), duration);
+}
+
+constexpr RgbwStep RgbwHold(roo_time::Duration duration) {
+  return BasicHold<RgbwColor>(duration);
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,43 @@
+#include "roo_blink/source/digits.h"
+
+namespace roo_blink {
+namespace internal {
+
+DigitEncoder::DigitEncoder(uint32_t value) : value_(value) { rewind(); }
+
+bool DigitEncoder::next(bool& on, uint8_t& units) {
+  if (gap_units_ > 0) {
+    on = false;
+    units = gap_units_;
+    gap_units_ = 0;
+    return true;
+  }
+  if (divisor_ == 0) return false;
+  uint8_t digit = (value_ / divisor_) % 10;
+  on = true;
+  if (digit == 0) {
+    units = 6;
+    remaining_pulses_ = 0;
+  } else {
+    units = 2;
+    if (remaining_pulses_ == 0) remaining_pulses_ = digit;
+    --remaining_pulses_;
+  }
+  if (remaining_pulses_ > 0) {
+    gap_units_ = 3;
+  } else {
+    divisor_ /= 10;
+    gap_units_ = (divisor_ == 0) ? 20 : 10;
+  }
+  return true;
+}
+
+void DigitEncoder::rewind() {
+  divisor_ = 1;
+  while (value_ / divisor_ >= 10) divisor_ *= 10;
+  remaining_pulses_ = 0;
+  gap_units_ = 0;
+}
+
+}  // namespace internal
+}  // namespace roo_blink
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "roo_blink/core/channels.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/monochrome/sequence.h"
+#include "roo_blink/rgb/sequence.h"
+#include "roo_blink/source/pulse_source.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+namespace internal {
+
+// Renders a number as groups of pulses, one group per decimal digit, most
+// significant first. A digit d > 0 is d short (2-unit) pulses, separated by
+// 3 units; zero is a single long (6-unit) pulse. Digits are separated by 10
+// units, and the number ends with a 20-unit gap.
+class DigitEncoder {
+ public:
+  explicit DigitEncoder(uint32_t value);
+
+  bool next(bool& on, uint8_t& units);
+  void rewind();
+
+ private:
+  uint32_t value_;
+  uint32_t divisor_;
+  uint8_t remaining_pulses_;
+  uint8_t gap_units_;
+};
+
+}  // namespace internal
+
+/// Streams a number as digit blinks, on an LED whose state is represented by
+/// Value. Useful for error codes and telemetry values. E.g. 203 is blinked
+/// as: 2 short pulses, pause, 1 long pulse (zero), pause, 3 short pulses,
+/// long pause.
+template <typename Value>
+class BasicDigitSource
+    : public internal::PulseSource<BasicStep<Value>, internal::DigitEncoder> {
+ public:
+  /// Creates a source that blinks the decimal digits of the value, using the
+  /// specified time unit (see internal::DigitEncoder), setting the LED to
+  /// `on` for the pulses.
+  BasicDigitSource(uint32_t value,
+                   roo_time::Duration unit = roo_time::Millis(100),
+                   Value on = ChannelTraits<Value>::Full())
+      : internal::PulseSource<BasicStep<Value>, internal::DigitEncoder>(
+            internal::DigitEncoder(value), BasicSetTo(on), BasicSetTo(Value()),
+            &BasicHold<Value>, unit) {}
+};
+
+/// Streams a number as digit blinks on a monochrome LED.
+using DigitSource = BasicDigitSource<uint16_t>;
+
+/// Streams a number as digit blinks on an RGB LED.
+using RgbDigitSource = BasicDigitSource<Color>;
+
+}  // namespace roo_blink
@@ -0,0 +1,85 @@
+#include "roo_blink/source/morse.h"
+
+namespace roo_blink {
+namespace internal {
+
+namespace {
+
+static const char* const kLetters[] = {
+    ".-",   "-...", "-.-.", "-..",  ".",    "..-.", "--.",  "....", "..",
+    ".---", "-.-",  ".-..", "--",   "-.",   "---",  ".--.", "--.-", ".-.",
+    "...",  "-",    "..-",  "...-", ".--",  "-..-", "-.--", "--..",
+};
+
+static const char* const kDigits[] = {
+    "-----", ".----", "..---", "...--", "....-",
+    ".....", "-....", "--...", "---..", "----.",
+};
+
+// Returns the dot-dash representation of the character, or nullptr if the
+// character has none.
+const char* MorseCode(char c) {
+  if (c >= 'a' && c <= 'z') return kLetters[c - 'a'];
+  if (c >= 'A' && c <= 'Z') return kLetters[c - 'A'];
+  if (c >= '0' && c <= '9') return kDigits[c - '0'];
+  switch (c) {
+    case '.':
+      return ".-.-.-";
+    case ',':
+      return "--..--";
+    case '?':
+      return "..--..";
+    case '/':
+      return "-..-.";
+    case '-':
+      return "-....-";
+    case '=':
+      return "-...-";
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+MorseEncoder::MorseEncoder(const char* text)
+    : text_(text), pos_(0), element_(0), gap_units_(0) {}
+
+bool MorseEncoder::next(bool& on, uint8_t& units) {
+  if (gap_units_ > 0) {
+    on = false;
+    units = gap_units_;
+    gap_units_ = 0;
+    return true;
+  }
+  while (text_[pos_] != '\0') {
+    const char* code = MorseCode(text_[pos_]);
+    if (code == nullptr) {
+      ++pos_;
+      continue;
+    }
+    on = true;
+    units = (code[element_] == '-') ? 3 : 1;
+    ++element_;
+    if (code[element_] != '\0') {
+      gap_units_ = 1;
+    } else {
+      element_ = 0;
+      ++pos_;
+      // Also true at the end of the text.
+      bool end_of_word = (MorseCode(text_[pos_]) == nullptr);
+      gap_units_ = end_of_word ? 7 : 3;
+    }
+    return true;
+  }
+  return false;
+}
+
+void MorseEncoder::rewind() {
+  pos_ = 0;
+  element_ = 0;
+  gap_units_ = 0;
+}
+
+}  // namespace internal
+}  // namespace roo_blink
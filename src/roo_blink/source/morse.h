@@ -0,0 +1,58 @@
+#pragma once
+
+#include "roo_blink/core/channels.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/monochrome/sequence.h"
+#include "roo_blink/rgb/sequence.h"
+#include "roo_blink/source/pulse_source.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+namespace internal {
+
+// Renders text as Morse code pulses. A dot is 1 unit long, a dash 3 units.
+// Elements are separated by 1 unit, letters by 3 units, and words by 7 units.
+// The message ends with a word gap, so that repetitions are distinguishable.
+// Letters, digits, and a few punctuation characters are supported; others
+// are treated as word separators. The text is not copied.
+class MorseEncoder {
+ public:
+  explicit MorseEncoder(const char* text);
+
+  bool next(bool& on, uint8_t& units);
+  void rewind();
+
+ private:
+  const char* text_;
+  size_t pos_;
+  uint8_t element_;
+  uint8_t gap_units_;
+};
+
+}  // namespace internal
+
+/// Streams text as Morse code, on an LED whose state is represented by Value.
+template <typename Value>
+class BasicMorseSource
+    : public internal::PulseSource<BasicStep<Value>, internal::MorseEncoder> {
+ public:
+  /// Creates a source that blinks the text in Morse code, with the specified
+  /// dot duration, setting the LED to `on` for the pulses. The text is not
+  /// copied, so that memory use does not depend on its length; it must stay
+  /// valid for the lifetime of the source (e.g. a string literal).
+  BasicMorseSource(const char* text,
+                   roo_time::Duration unit = roo_time::Millis(120),
+                   Value on = ChannelTraits<Value>::Full())
+      : internal::PulseSource<BasicStep<Value>, internal::MorseEncoder>(
+            internal::MorseEncoder(text), BasicSetTo(on),
+            BasicSetTo(Value()), &BasicHold<Value>, unit) {}
+};
+
+/// Streams text as Morse code on a monochrome LED.
+using MorseSource = BasicMorseSource<uint16_t>;
+
+/// Streams text as Morse code on an RGB LED.
+using RgbMorseSource = BasicMorseSource<Color>;
+
+}  // namespace roo_blink
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "roo_blink/source/step_source.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+namespace internal {
+
+// Step source that renders on/off pulses, produced by the Encoder, as
+// set-and-hold step pairs. The Encoder must provide:
+//
+//   // Returns the next pulse, with duration in time units, or false at end.
+//   bool next(bool& on, uint8_t& units);
+//   // Restarts from the first pulse.
+//   void rewind();
+template <typename StepT, typename Encoder>
+class PulseSource : public StepSource<StepT> {
+ public:
+  PulseSource(Encoder encoder, StepT on, StepT off,
+              StepT (*hold)(roo_time::Duration), roo_time::Duration unit)
+      : encoder_(std::move(encoder)),
+        on_(on),
+        off_(off),
+        hold_(hold),
+        unit_(unit),
+        pending_hold_units_(0) {}
+
+  size_t read(StepT* buf, size_t max_count) override {
+    size_t count = 0;
+    while (count < max_count) {
+      if (pending_hold_units_ > 0) {
+        buf[count++] = hold_(roo_time::Micros(unit_.inMicros() *
+                                              pending_hold_units_));
+        pending_hold_units_ = 0;
+        continue;
+      }
+      bool on;
+      if (!encoder_.next(on, pending_hold_units_)) break;
+      buf[count++] = on ? on_ : off_;
+    }
+    return count;
+  }
+
+  void rewind() override {
+    encoder_.rewind();
+    pending_hold_units_ = 0;
+  }
+
+ private:
+  Encoder encoder_;
+  StepT on_;
+  StepT off_;
+  StepT (*hold_)(roo_time::Duration);
+  roo_time::Duration unit_;
+  uint8_t pending_hold_units_;
+};
+
+}  // namespace internal
+}  // namespace roo_blink
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+
+namespace roo_blink {
+
+/// Supplies steps of a blink sequence on demand.
+///
+/// Blinkers pull steps from the source as they go, a few at a time, so the
+/// memory used does not depend on the length of the sequence. Use it for
+/// long or data-driven patterns (e.g. MorseSource, DigitSource). Steps are
+/// requested from the blinker's scheduler thread.
+///
+/// A source holds playback state, so it must not be played by more than one
+/// blinker at a time.
+template <typename StepT>
+class StepSource {
+ public:
+  virtual ~StepSource() = default;
+
+  /// Writes up to `max_count` subsequent steps to `buf`, and returns the
+  /// number of steps written. Returning zero signals the end of the sequence.
+  virtual size_t read(StepT* buf, size_t max_count) = 0;
+
+  /// Restarts the sequence from the first step. Called when the sequence is
+  /// played again, e.g. via Blinker::loop() or Blinker::repeat().
+  virtual void rewind() = 0;
+};
+
+}  // namespace roo_blink
@@ -0,0 +1,207 @@
+#include "roo_blink/trace.h"
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "roo_time.h"
+
+namespace roo_blink {
+
+namespace {
+
+// Writes the VCD identifier of the signal with the specified index: a string
+// of printable characters, '!' to '~'.
+void VcdId(uint32_t index, char* out) {
+  do {
+    *out++ = (char)('!' + index % 94);
+    index /= 94;
+  } while (index > 0);
+  *out = '\0';
+}
+
+}  // namespace
+
+const char* TraceEventName(TraceEvent event) {
+  switch (event) {
+    case TraceEvent::kWrite:
+      return "write";
+    case TraceEvent::kSchedule:
+      return "schedule";
+    case TraceEvent::kFrameRequest:
+      return "frame";
+    case TraceEvent::kStep:
+      return "step";
+    case TraceEvent::kStart:
+      return "start";
+    case TraceEvent::kComplete:
+      return "complete";
+    case TraceEvent::kCancel:
+      return "cancel";
+    case TraceEvent::kSupersede:
+      return "supersede";
+    case TraceEvent::kFade:
+    default:
+      return "fade";
+  }
+}
+
+TraceRecorder::TraceRecorder(size_t capacity) : next_(0), start_(0) {
+  uint32_t size = 1;
+  while (size < capacity) size <<= 1;
+  slots_.reset(new Slot[size]);
+  mask_ = size - 1;
+  for (uint32_t i = 0; i < size; ++i) {
+    slots_[i].seq.store(0, std::memory_order_relaxed);
+  }
+}
+
+void TraceRecorder::record(uint16_t channel, TraceEvent event,
+                           uint32_t value) {
+  uint32_t index = next_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = slots_[index & mask_];
+  slot.seq.store(0, std::memory_order_relaxed);
+  // Makes readers see the slot as busy before any of the new payload.
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.time_us.store((uint32_t)roo_time::Uptime::Now().inMicros(),
+                     std::memory_order_relaxed);
+  slot.tag.store(((uint32_t)channel << 16) | (uint8_t)event,
+                 std::memory_order_relaxed);
+  slot.value.store(value, std::memory_order_relaxed);
+  slot.seq.store(index + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::read(uint32_t index, TraceEntry& entry) const {
+  const Slot& slot = slots_[index & mask_];
+  if (slot.seq.load(std::memory_order_acquire) != index + 1) return false;
+  entry.time_us = slot.time_us.load(std::memory_order_relaxed);
+  uint32_t tag = slot.tag.load(std::memory_order_relaxed);
+  entry.value = slot.value.load(std::memory_order_relaxed);
+  // Detects a writer that has taken over the slot while it was being read.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.seq.load(std::memory_order_relaxed) != index + 1) return false;
+  entry.channel = (uint16_t)(tag >> 16);
+  entry.event = (TraceEvent)(tag & 0xFF);
+  return true;
+}
+
+uint32_t TraceRecorder::oldest(uint32_t next) const {
+  uint32_t count = next - start_.load(std::memory_order_relaxed);
+  if (count > mask_ + 1) count = mask_ + 1;
+  return next - count;
+}
+
+size_t TraceRecorder::snapshot(TraceEntry* out, size_t max_count) const {
+  uint32_t next = next_.load(std::memory_order_acquire);
+  uint32_t begin = oldest(next);
+  if (next - begin > max_count) begin = next - (uint32_t)max_count;
+  size_t count = 0;
+  for (uint32_t i = begin; i != next; ++i) {
+    if (read(i, out[count])) ++count;
+  }
+  return count;
+}
+
+void TraceRecorder::clear() {
+  start_.store(next_.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+}
+
+void TraceRecorder::exportCsv(Print& out) const {
+  char line[48];
+  out.print("time_us,channel,event,value\n");
+  uint32_t next = next_.load(std::memory_order_acquire);
+  for (uint32_t i = oldest(next); i != next; ++i) {
+    TraceEntry entry;
+    if (!read(i, entry)) continue;
+    snprintf(line, sizeof(line), "%lu,%u,%s,%lu\n",
+             (unsigned long)entry.time_us, (unsigned)entry.channel,
+             TraceEventName(entry.event), (unsigned long)entry.value);
+    out.print(line);
+  }
+}
+
+void TraceRecorder::exportVcd(Print& out) const {
+  uint32_t next = next_.load(std::memory_order_acquire);
+  uint32_t begin = oldest(next);
+
+  // First pass: find the time origin, and the channels to declare, sorted.
+  bool any = false;
+  uint32_t start_time = 0;
+  std::vector<uint16_t> channels;
+  for (uint32_t i = begin; i != next; ++i) {
+    TraceEntry entry;
+    if (!read(i, entry)) continue;
+    if (!any) start_time = entry.time_us;
+    any = true;
+    auto pos = std::lower_bound(channels.begin(), channels.end(),
+                                entry.channel);
+    if (pos == channels.end() || *pos != entry.channel) {
+      channels.insert(pos, entry.channel);
+    }
+  }
+
+  char line[48];
+  char id[8];
+  out.print("$timescale 1us $end\n$scope module roo_blink $end\n");
+  for (uint32_t slot = 0; slot < channels.size(); ++slot) {
+    unsigned channel = channels[slot];
+    VcdId(3 * slot, id);
+    snprintf(line, sizeof(line), "$var wire 32 %s led%u $end\n", id,
+             channel);
+    out.print(line);
+    VcdId(3 * slot + 1, id);
+    snprintf(line, sizeof(line), "$var wire 32 %s fade%u $end\n", id,
+             channel);
+    out.print(line);
+    VcdId(3 * slot + 2, id);
+    snprintf(line, sizeof(line), "$var event 1 %s step%u $end\n", id,
+             channel);
+    out.print(line);
+  }
+  out.print("$upscope $end\n$enddefinitions $end\n");
+  if (!any) return;
+
+  // Second pass: the value changes. Entries recorded concurrently by
+  // different threads may be slightly out of order; VCD requires
+  // non-decreasing times, so these are clamped.
+  uint32_t time = 0;
+  bool time_written = false;
+  for (uint32_t i = begin; i != next; ++i) {
+    TraceEntry entry;
+    if (!read(i, entry)) continue;
+    if (entry.event != TraceEvent::kWrite && entry.event != TraceEvent::kFade &&
+        entry.event != TraceEvent::kStep) {
+      continue;
+    }
+    // Entries recorded after the first pass may be on undeclared channels.
+    auto pos = std::lower_bound(channels.begin(), channels.end(),
+                                entry.channel);
+    if (pos == channels.end() || *pos != entry.channel) continue;
+    uint32_t slot = pos - channels.begin();
+    uint32_t t = entry.time_us - start_time;
+    if (t > time || !time_written) {
+      if (t > time) time = t;
+      snprintf(line, sizeof(line), "#%lu\n", (unsigned long)time);
+      out.print(line);
+      time_written = true;
+    }
+    if (entry.event != TraceEvent::kStep) {
+      VcdId(3 * slot + (entry.event == TraceEvent::kFade ? 1 : 0), id);
+      char* p = line;
+      *p++ = 'b';
+      int bit = 31;
+      while (bit > 0 && (entry.value >> bit) == 0) --bit;
+      for (; bit >= 0; --bit) *p++ = ((entry.value >> bit) & 1) ? '1' : '0';
+      snprintf(p, line + sizeof(line) - p, " %s\n", id);
+    } else {
+      VcdId(3 * slot + 2, id);
+      snprintf(line, sizeof(line), "1%s\n", id);
+    }
+    out.print(line);
+  }
+}
+
+}  // namespace roo_blink
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+class Print;
+
+namespace roo_blink {
+
+/// Type of an event recorded by a TraceRecorder.
+enum class TraceEvent : uint8_t {
+  /// The LED was written. The value holds the channels, packed big-endian
+  /// (e.g. 0x00RRGGBB for RGB, 0xWARMCOOL for tunable white).
+  kWrite = 0,
+
+  /// The next step was scheduled. The value is the delay, in milliseconds.
+  kSchedule = 1,
+
+  /// The next software fade update was requested from the frame scheduler.
+  kFrameRequest = 2,
+
+  /// The blinker ran. The value is how late it ran relative to when it was
+  /// scheduled (or, if run by a frame scheduler, to when the frame was due),
+  /// in microseconds.
+  kStep = 3,
+
+  /// A sequence was started. The value is the number of remaining
+  /// repetitions, or 0xFFFFFFFF if looping.
+  kStart = 4,
+
+  /// The sequence completed.
+  kComplete = 5,
+
+  /// The sequence was cancelled.
+  kCancel = 6,
+
+  /// The sequence was superseded by another one.
+  kSupersede = 7,
+
+  /// A hardware fade was started. The value holds the target channels,
+  /// packed as for kWrite. It is followed by a kSchedule entry with the
+  /// duration of the fade, unless zero.
+  kFade = 8,
+};
+
+/// Returns a short name of the event, as used in CSV exports.
+const char* TraceEventName(TraceEvent event);
+
+/// Single entry of a trace.
+struct TraceEntry {
+  /// Uptime, in microseconds, modulo 2^32.
+  uint32_t time_us;
+
+  /// Identifier of the blinker, as given to setTracer().
+  uint16_t channel;
+
+  TraceEvent event;
+
+  uint32_t value;
+};
+
+/// Records output writes and scheduling events of blinkers (see
+/// BlinkEngine::setTracer()), so that the actual timeline can be compared
+/// offline against the intended one, and jitter measured.
+///
+/// Entries go to a fixed-size ring buffer, overwriting the oldest ones.
+/// Recording is lock-free, and safe to call from any number of threads: it
+/// reserves a slot with a single atomic increment, and publishes the entry
+/// with a per-slot sequence number, so that concurrent exports skip entries
+/// that are being written, rather than reading them torn.
+class TraceRecorder {
+ public:
+  /// Creates a recorder that keeps the most recent entries, up to the
+  /// capacity, rounded up to a power of two.
+  explicit TraceRecorder(size_t capacity = 256);
+
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  /// Records an event, timestamped with the current uptime.
+  void record(uint16_t channel, TraceEvent event, uint32_t value);
+
+  /// Returns the number of slots in the ring buffer.
+  size_t capacity() const { return mask_ + 1; }
+
+  /// Returns the total number of entries recorded so far, including those
+  /// already overwritten.
+  uint32_t recorded() const {
+    return next_.load(std::memory_order_relaxed);
+  }
+
+  /// Copies up to `max_count` most recent entries to `out`, oldest first.
+  /// Returns the number of entries copied.
+  size_t snapshot(TraceEntry* out, size_t max_count) const;
+
+  /// Discards all entries.
+  void clear();
+
+  /// Writes the entries, oldest first, as CSV with the columns: time_us,
+  /// channel, event, value.
+  void exportCsv(Print& out) const;
+
+  /// Writes the entries as a Value Change Dump, viewable e.g. in GTKWave. Each
+  /// channel gets a 32-bit signal with the written values, a 32-bit signal
+  /// with the targets of hardware fades, and an event signal that fires
+  /// whenever the blinker runs. Times are relative to the oldest entry.
+  void exportVcd(Print& out) const;
+
+ private:
+  struct Slot {
+    // Index of the entry plus one, once written; zero while being written.
+    std::atomic<uint32_t> seq;
+
+    std::atomic<uint32_t> time_us;
+    // Channel in the upper 16 bits, event in the lower 8 bits.
+    std::atomic<uint32_t> tag;
+    std::atomic<uint32_t> value;
+  };
+
+  // Reads the entry with the specified index. Returns false if it has been,
+  // or is being, overwritten.
+  bool read(uint32_t index, TraceEntry& entry) const;
+
+  // Returns the index of the oldest entry that has not been overwritten.
+  uint32_t oldest(uint32_t next) const;
+
+  std::unique_ptr<Slot[]> slots_;
+  uint32_t mask_;
+  std::atomic<uint32_t> next_;
+
+  // Index of the first entry retained after clear().
+  std::atomic<uint32_t> start_;
+};
+
+}  // namespace roo_blink
@@ -0,0 +1,7 @@
+#include "roo_blink/white/blinker.h"
+
+namespace roo_blink {
+
+template class BlinkEngine<White, WhiteLed>;
+
+}  // namespace roo_blink
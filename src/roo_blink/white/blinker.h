@@ -0,0 +1,20 @@
+#pragma once
+
+#include "roo_blink/core/engine.h"
+#include "roo_blink/white/led.h"
+#include "roo_blink/white/sequence.h"
+
+namespace roo_blink {
+
+/// Runs blink sequences on a tunable-white LED of type LedT, which needs to
+/// provide setWhite(White), as in WhiteLed.
+template <typename LedT>
+using BasicWhiteBlinker = BlinkEngine<White, LedT>;
+
+/// Runs blink sequences on a tunable-white LED. Accepts any WhiteLed
+/// implementation.
+using WhiteBlinker = BasicWhiteBlinker<WhiteLed>;
+
+extern template class BlinkEngine<White, WhiteLed>;
+
+}  // namespace roo_blink
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <inttypes.h>
+
+namespace roo_blink {
+
+/// State of a tunable-white LED, which mixes a warm and a cool white emitter
+/// to vary the color temperature.
+class White {
+ public:
+  /// Creates the 'off' state (both emitters off).
+  constexpr White() : warm_(0), cool_(0) {}
+
+  /// Creates a state from the warm and cool emitter levels, each in the range
+  /// 0 (off) to 65535 (max).
+  constexpr White(uint16_t warm, uint16_t cool) : warm_(warm), cool_(cool) {}
+
+  /// Returns the warm emitter level.
+  uint16_t warm() const { return warm_; }
+  /// Returns the cool emitter level.
+  uint16_t cool() const { return cool_; }
+
+ private:
+  uint16_t warm_;
+  uint16_t cool_;
+};
+
+}  // namespace roo_blink
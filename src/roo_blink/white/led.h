@@ -0,0 +1,15 @@
+#pragma once
+
+#include "roo_blink/white/color.h"
+#include "stdint.h"
+
+namespace roo_blink {
+
+/// Abstract interface representing a tunable-white LED.
+class WhiteLed {
+ public:
+  /// Sets the levels of the warm and cool emitters.
+  virtual void setWhite(White white) = 0;
+};
+
+}  // namespace roo_blink
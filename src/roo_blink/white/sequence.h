@@ -0,0 +1,64 @@
+#pragma once
+
+#include "roo_blink/core/sequence.h"
+#include "roo_blink/core/step.h"
+#include "roo_blink/source/step_source.h"
+#include "roo_blink/white/color.h"
+#include "roo_time.h"
+
+namespace roo_blink {
+
+/// Single step of a tunable-white blink sequence.
+using WhiteStep = BasicStep<White>;
+
+/// Source of steps for streaming tunable-white sequences.
+using WhiteBlinkSource = StepSource<WhiteStep>;
+
+/// Sequence of steps for tunable-white blinking.
+using WhiteBlinkSequence = BasicSequence<White>;
+
+/// Creates a step that sets the emitter levels instantly.
+constexpr WhiteStep WhiteSetTo(White white);
+
+/// Creates a step that disables the LED. Equivalent to WhiteSetTo(White()).
+constexpr WhiteStep WhiteTurnOff();
+
+/// Creates a step that fades linearly, per emitter, to the target levels over
+/// the duration. Fading between mostly-warm and mostly-cool levels sweeps
+/// the color temperature.
+constexpr WhiteStep WhiteFadeTo(White white, roo_time::Duration duration);
+
+/// Creates a step that fades the LED off over the duration.
+constexpr WhiteStep WhiteFadeOff(roo_time::Duration duration);
+
+/// Creates a step that holds the current levels for the duration.
+constexpr WhiteStep WhiteHold(roo_time::Duration duration);
+
+/// Creates a symmetric blink sequence with optional ramp-up/down segments.
+inline WhiteBlinkSequence WhiteBlink(roo_time::Duration period, White white,
+                                     int duty_percent = 50,
+                                     int rampup_percent_on = 0,
+                                     int rampup_percent_off = 0) {
+  return BasicBlink(period, white, duty_percent, rampup_percent_on,
+                    rampup_percent_off);
+}
+
+// Implementation details.
+
+constexpr WhiteStep WhiteSetTo(White white) { return BasicSetTo(white); }
+
+constexpr WhiteStep WhiteTurnOff() { return WhiteSetTo(White()); }
+
+constexpr WhiteStep WhiteFadeTo(White white, roo_time::Duration duration) {
+  return BasicFadeTo(white, duration);
+}
+
+constexpr WhiteStep WhiteFadeOff(roo_time::Duration duration) {
+  return WhiteFadeTo(White(), duration);
+}
+
+constexpr WhiteStep WhiteHold(roo_time::Duration duration) {
+  return BasicHold<White>(duration);
+}
+
+}  // namespace roo_blink